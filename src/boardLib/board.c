@@ -0,0 +1,478 @@
+/** @file
+ * Implementation of storage of fields
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+/** Enables MAP_ANONYMOUS */
+#define _DEFAULT_SOURCE
+
+#include "board.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * Multiplier of Fibonacci hashing.
+ */
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15u
+
+/**
+ * Initial number of slots in hash map of tiles.
+ */
+#define INITIAL_TILES 64
+
+/** @brief Gives board without memory.
+ * @param width - game width
+ * @param height - game height
+ * @return board of given size, which doesn't keep any Nodes
+ */
+static Board boardOf(uint32_t width, uint32_t height);
+
+/** @brief Makes fields of border of tile owned by BORDER_OWNER.
+ * @param b - board
+ * @param nodes - Nodes of tile
+ * @param first - index of first field of tile
+ * @param count - number of fields of tile
+ */
+static void fillBorder(const Board *b, Node *nodes, cell_t first,
+                       uint64_t count);
+
+/** @brief Makes dense board with mapped Nodes and bitmap of chunks.
+ * @param b - board with size set
+ * @return false if there was not enough memory else true
+ */
+static bool mapDense(Board *b);
+
+/** @brief Gives number of chunks of dense board.
+ * @param b - dense board
+ * @return number of chunks
+ */
+static uint64_t chunksOf(const Board *b);
+
+/** @brief Marks chunk of field as touched.
+ * @param b - dense board
+ * @param elem - index of field
+ */
+static void markChunk(Board *b, cell_t elem);
+
+/** @brief Checks if chunk was touched.
+ * @param b - dense board
+ * @param chunk - index of chunk
+ * @return true if chunk was touched else false
+ */
+static bool isChunkTouched(const Board *b, uint64_t chunk);
+
+/** @brief Gives number of fields of chunk that are on the board.
+ * @param b - dense board
+ * @param chunk - index of chunk
+ * @return number of fields of chunk
+ */
+static uint64_t chunkLength(const Board *b, uint64_t chunk);
+
+/** @brief Maps memory for Nodes of dense board.
+ * Pages of mapping are filled with zeros and taken from the system only
+ * when they are used for the first time.
+ * @param size - number of fields
+ * @return Nodes of empty fields or NULL if there was not enough memory
+ */
+static Node *mapNodes(uint64_t size);
+
+/** @brief Gives field of Node of file board.
+ * @param b - file board
+ * @param index - index of Node in mapped tiles
+ * @return index of field or NO_CELL if Node is outside of board
+ */
+static cell_t mappedField(const Board *b, uint64_t index);
+
+/** @brief Gives slot of tile in hash map.
+ * @param tiles - hash map of tiles
+ * @param capacity - number of slots, power of 2
+ * @param index - index of tile
+ * @return slot with tile @p index or free slot where it should be
+ */
+static tile *findTile(tile *tiles, uint64_t capacity, uint64_t index);
+
+/** @brief Doubles number of slots of hash map of tiles.
+ * @param b - sparse board
+ * @return false if there was not enough memory else true
+ */
+static bool growTiles(Board *b);
+
+/** @brief Gives number of fields of tile that are on the board.
+ * @param b - board
+ * @param first - index of first field of tile
+ * @return number of fields of tile
+ */
+static uint64_t tileLength(const Board *b, cell_t first);
+
+// ----------------------------------------------------------------------------
+
+static Board boardOf(uint32_t width, uint32_t height) {
+    Node border = {BORDER_OWNER, 0, 0, 0, false};
+
+    return (Board) {NULL, NULL, boardSize(width, height), width, height,
+                    (uint64_t) width + 1, NULL, 0, 0, {0}, border,
+                    NULL, 0, NULL, 0, 0, -1};
+}
+
+static void fillBorder(const Board *b, Node *nodes, cell_t first,
+                       uint64_t count) {
+    for (uint64_t i = 0; i < count; i++)
+        if (isBorder(b, first + i))
+            nodes[i] = b->border;
+}
+
+bool initDenseBoard(Board *b, uint32_t width, uint32_t height) {
+    *b = boardOf(width, height);
+
+    // Node made of zeros is empty root, border is written by touchNode()
+    return mapDense(b);
+}
+
+void writeBorder(Board *b) {
+    memset(b->touched, 0xff, (chunksOf(b) + 63) / 64 * sizeof(uint64_t));
+
+    fillBorder(b, b->nodes, 0, b->stride);
+    for (uint64_t y = 1; y <= b->height; y++)
+        b->nodes[y * b->stride] = b->border;
+    fillBorder(b, b->nodes + (b->size - b->stride), b->size - b->stride,
+               b->stride);
+}
+
+bool initSparseBoard(Board *b, uint32_t width, uint32_t height) {
+    *b = boardOf(width, height);
+    return growTiles(b);
+}
+
+bool initFileBoard(Board *b, uint32_t width, uint32_t height,
+                   const char *path, uint64_t offset, bool create) {
+    uint64_t tilesInRow = (width + MAPPED_TILE_SIDE - 1) >> MAPPED_TILE_BITS;
+    uint64_t tilesInColumn = (height + MAPPED_TILE_SIDE - 1) >>
+                             MAPPED_TILE_BITS;
+    uint64_t mappedSize = tilesInRow * tilesInColumn << (2u * MAPPED_TILE_BITS);
+
+    // border isn't kept in file
+    *b = boardOf(width, height);
+    b->mappedSize = mappedSize;
+    b->tilesInRow = tilesInRow;
+
+    if (mappedSize > SIZE_MAX / sizeof(Node) ||
+        (uint64_t) INT64_MAX - offset < mappedSize * sizeof(Node))
+        return false;
+
+    uint64_t length = offset + mappedSize * sizeof(Node);
+    int file = open(path, create ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR, 0666);
+    if (file < 0)
+        return false;
+
+    // file grows with zeros, which are empty roots
+    struct stat status;
+    bool correct = create ? ftruncate(file, length) == 0 :
+                   fstat(file, &status) == 0 &&
+                   (uint64_t) status.st_size >= length;
+
+    // head is mapped too, so it's written back together with tiles
+    void *head = correct ? mmap(NULL, length, PROT_READ | PROT_WRITE,
+                                MAP_SHARED, file, 0) : MAP_FAILED;
+    if (head == MAP_FAILED) {
+        close(file);
+        return false;
+    }
+
+    b->head = head;
+    b->headSize = offset;
+    b->mapped = (Node *) (b->head + offset);
+    b->file = file;
+    return true;
+}
+
+bool syncBoard(Board *b) {
+    return msync(b->head, b->headSize + b->mappedSize * sizeof(Node),
+                 MS_SYNC) == 0;
+}
+
+void freeBoard(Board *b) {
+    for (uint64_t i = 0; i < b->tilesCapacity; i++)
+        free(b->tiles[i].nodes);
+
+    if (b->nodes != NULL)
+        munmap(b->nodes, b->size * sizeof(Node));
+    free(b->touched);
+    if (b->mapped != NULL) {
+        munmap(b->head, b->headSize + b->mappedSize * sizeof(Node));
+        close(b->file);
+    }
+
+    free(b->tiles);
+    *b = boardOf(0, 0);
+}
+
+bool copyBoard(Board *copy, const Board *b) {
+    *copy = boardOf(b->width, b->height);
+
+    if (b->nodes != NULL) {
+        if (!mapDense(copy))
+            return false;
+
+        // copy is mapped lazily as well, untouched chunks stay zeros
+        uint64_t chunks = chunksOf(b);
+        memcpy(copy->touched, b->touched,
+               (chunks + 63) / 64 * sizeof(uint64_t));
+
+        for (uint64_t chunk = 0; chunk < chunks; chunk++)
+            if (isChunkTouched(b, chunk))
+                memcpy(&copy->nodes[chunk << CHUNK_BITS],
+                       &b->nodes[chunk << CHUNK_BITS],
+                       chunkLength(b, chunk) * sizeof(Node));
+        return true;
+    }
+
+    if (b->mapped != NULL) {
+        if (!mapDense(copy))
+            return false;
+
+        // file is read in order, empty fields of copy are already zeros
+        for (uint64_t index = 0; index < b->mappedSize; index++) {
+            const Node *node = &b->mapped[index];
+            cell_t elem = mappedField(b, index);
+            if (elem == NO_CELL || memcmp(node, &b->empty, sizeof(Node)) == 0)
+                continue;
+
+            copy->nodes[elem] = *node;
+            touchNode(copy, elem);
+        }
+        return true;
+    }
+
+    copy->tiles = calloc(b->tilesCapacity, sizeof(tile));
+    if (copy->tiles == NULL)
+        return false;
+    copy->tilesCapacity = b->tilesCapacity;
+
+    for (uint64_t i = 0; i < b->tilesCapacity; i++) {
+        if (b->tiles[i].nodes == NULL)
+            continue;
+
+        Node *nodes = malloc(TILE_SIZE * sizeof(Node));
+        if (nodes == NULL)
+            return false;
+
+        memcpy(nodes, b->tiles[i].nodes, TILE_SIZE * sizeof(Node));
+        copy->tiles[i] = (tile) {b->tiles[i].index, nodes};
+        copy->tilesSize++;
+    }
+
+    return true;
+}
+
+static bool mapDense(Board *b) {
+    b->nodes = mapNodes(b->size);
+    b->touched = calloc((chunksOf(b) + 63) / 64, sizeof(uint64_t));
+
+    if (b->nodes == NULL || b->touched == NULL) {
+        if (b->nodes != NULL)
+            munmap(b->nodes, b->size * sizeof(Node));
+        free(b->touched);
+        b->nodes = NULL;
+        b->touched = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+static uint64_t chunksOf(const Board *b) {
+    return (b->size + CHUNK_SIZE - 1) >> CHUNK_BITS;
+}
+
+static void markChunk(Board *b, cell_t elem) {
+    uint64_t chunk = elem >> CHUNK_BITS;
+    b->touched[chunk / 64] |= UINT64_C(1) << (chunk % 64);
+}
+
+static bool isChunkTouched(const Board *b, uint64_t chunk) {
+    return (b->touched[chunk / 64] >> (chunk % 64) & 1u) != 0;
+}
+
+static uint64_t chunkLength(const Board *b, uint64_t chunk) {
+    uint64_t first = chunk << CHUNK_BITS;
+    return b->size - first < CHUNK_SIZE ? b->size - first : CHUNK_SIZE;
+}
+
+static Node *mapNodes(uint64_t size) {
+    if (size == 0 || size > SIZE_MAX / sizeof(Node))
+        return NULL;
+
+    size_t length = size * sizeof(Node);
+    void *nodes = mmap(NULL, length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (nodes == MAP_FAILED)
+        return NULL;
+
+    return nodes;
+}
+
+static cell_t mappedField(const Board *b, uint64_t index) {
+    uint64_t mask = MAPPED_TILE_SIDE - 1;
+    uint64_t tile = index >> (2u * MAPPED_TILE_BITS);
+    uint64_t x = (tile % b->tilesInRow) << MAPPED_TILE_BITS | (index & mask);
+    uint64_t y = (tile / b->tilesInRow) << MAPPED_TILE_BITS |
+                 (index >> MAPPED_TILE_BITS & mask);
+
+    if (x >= b->width || y >= b->height)
+        return NO_CELL;
+
+    return (y + 1) * b->stride + x + 1;
+}
+
+static tile *findTile(tile *tiles, uint64_t capacity, uint64_t index) {
+    uint64_t mask = capacity - 1;
+    uint64_t slot = ((index * HASH_MULTIPLIER) >> 32u) & mask;
+
+    while (tiles[slot].nodes != NULL && tiles[slot].index != index)
+        slot = (slot + 1) & mask;
+
+    return &tiles[slot];
+}
+
+static bool growTiles(Board *b) {
+    uint64_t capacity = b->tilesCapacity == 0 ?
+                        INITIAL_TILES : 2 * b->tilesCapacity;
+    if (capacity > SIZE_MAX / sizeof(tile))
+        return false;
+
+    tile *tiles = calloc(capacity, sizeof(tile));
+    if (tiles == NULL)
+        return false;
+
+    for (uint64_t i = 0; i < b->tilesCapacity; i++)
+        if (b->tiles[i].nodes != NULL)
+            *findTile(tiles, capacity, b->tiles[i].index) = b->tiles[i];
+
+    free(b->tiles);
+    b->tiles = tiles;
+    b->tilesCapacity = capacity;
+    return true;
+}
+
+static uint64_t tileLength(const Board *b, cell_t first) {
+    return b->size - first < TILE_SIZE ? b->size - first : TILE_SIZE;
+}
+
+Node *sparseNode(Board *b, cell_t elem) {
+    tile *t = findTile(b->tiles, b->tilesCapacity, elem >> TILE_BITS);
+    if (t->nodes == NULL)
+        return isBorder(b, elem) ? &b->border : &b->empty;
+
+    return &t->nodes[elem & (TILE_SIZE - 1)];
+}
+
+bool touchNode(Board *b, cell_t elem) {
+    if (b->nodes != NULL) {
+        // zeros of border look like empty fields to the nearby one
+        cell_t nearby[4] = {elem - 1, elem + 1,
+                            elem - b->stride, elem + b->stride};
+        markChunk(b, elem);
+        for (int i = 0; i < 4; i++)
+            if (isBorder(b, nearby[i])) {
+                b->nodes[nearby[i]] = b->border;
+                markChunk(b, nearby[i]);
+            }
+
+        return true;
+    }
+
+    if (b->mapped != NULL)
+        return true;
+
+    uint64_t index = elem >> TILE_BITS;
+    if (findTile(b->tiles, b->tilesCapacity, index)->nodes != NULL)
+        return true;
+
+    // keep hash map at most half full
+    if (2 * (b->tilesSize + 1) > b->tilesCapacity && !growTiles(b))
+        return false;
+
+    Node *nodes = calloc(TILE_SIZE, sizeof(Node));
+    if (nodes == NULL)
+        return false;
+
+    cell_t first = index << TILE_BITS;
+    fillBorder(b, nodes, first, tileLength(b, first));
+
+    *findTile(b->tiles, b->tilesCapacity, index) = (tile) {index, nodes};
+    b->tilesSize++;
+    return true;
+}
+
+const Node *nodesFrom(const Board *b, cell_t elem, uint64_t *count) {
+    if (b->nodes != NULL) {
+        *count = b->size - elem;
+        return &b->nodes[elem];
+    }
+
+    if (b->mapped != NULL) {
+        uint64_t index = mappedIndex(b, elem);
+        uint64_t x = elem % b->stride - 1;
+        uint64_t inTile = MAPPED_TILE_SIDE - (x & (MAPPED_TILE_SIDE - 1));
+
+        *count = b->width - x < inTile ? b->width - x : inTile;
+        return &b->mapped[index];
+    }
+
+    cell_t first = elem & ~(TILE_SIZE - 1);
+    *count = tileLength(b, first) - (elem - first);
+
+    tile *t = findTile(b->tiles, b->tilesCapacity, elem >> TILE_BITS);
+    return t->nodes == NULL ? NULL : &t->nodes[elem - first];
+}
+
+Node *nextNodes(Board *b, uint64_t *position, cell_t *first, uint64_t *count) {
+    if (b->nodes != NULL) {
+        for (; *position < chunksOf(b); ++*position) {
+            uint64_t chunk = *position;
+            if (!isChunkTouched(b, chunk))
+                continue;
+
+            ++*position;
+            *first = chunk << CHUNK_BITS;
+            *count = chunkLength(b, chunk);
+            return &b->nodes[*first];
+        }
+
+        return NULL;
+    }
+
+    if (b->mapped != NULL) {
+        // rows of tiles below the board are skipped
+        for (; *position < b->mappedSize; *position += MAPPED_TILE_SIDE) {
+            uint64_t index = *position;
+            *first = mappedField(b, index);
+            if (*first == NO_CELL)
+                continue;
+
+            *position += MAPPED_TILE_SIDE;
+            nodesFrom(b, *first, count);
+            return &b->mapped[index];
+        }
+
+        return NULL;
+    }
+
+    for (; *position < b->tilesCapacity; ++*position) {
+        tile *t = &b->tiles[*position];
+        if (t->nodes == NULL)
+            continue;
+
+        ++*position;
+        *first = t->index << TILE_BITS;
+        *count = tileLength(b, *first);
+        return t->nodes;
+    }
+
+    return NULL;
+}
@@ -0,0 +1,276 @@
+/** @file
+ * Interface of storage of fields
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+#ifndef GAMMA_BOARD_H
+#define GAMMA_BOARD_H
+
+#include "../findUnionLib/findUnion.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Number of bits of index of field inside its tile.
+ */
+#define TILE_BITS 8
+
+/**
+ * Number of fields in tile of sparse board.
+ */
+#define TILE_SIZE (UINT64_C(1) << TILE_BITS)
+
+/**
+ * Number of bits of index of field inside its chunk of dense board.
+ */
+#define CHUNK_BITS 12
+
+/**
+ * Number of fields in chunk of dense board, the part of it that is
+ * copied or searched at once.
+ */
+#define CHUNK_SIZE (UINT64_C(1) << CHUNK_BITS)
+
+/**
+ * Maximal number of fields of dense board.
+ */
+#define DENSE_LIMIT (UINT64_C(1) << 36u)
+
+/**
+ * Dense board with more fields becomes sparse if it can't be mapped.
+ */
+#define SPARSE_FALLBACK UINT32_MAX
+
+/**
+ * Owner of fields of border around the board, never a player.
+ */
+#define BORDER_OWNER UINT32_MAX
+
+/**
+ * Number of bits of coordinate of field inside its tile of file board.
+ */
+#define MAPPED_TILE_BITS 5
+
+/**
+ * Width and height of tile of file board.
+ */
+#define MAPPED_TILE_SIDE (UINT64_C(1) << MAPPED_TILE_BITS)
+
+/** @brief Slot of hash map of tiles.
+ */
+struct tile {
+    uint64_t index;             /**< Index of first field divided by
+                                     TILE_SIZE */
+    Node *nodes;                /**< Nodes of tile or NULL if slot is free */
+};
+
+/**
+ * Slot of hash map of tiles.
+ */
+typedef struct tile tile;
+
+/** @brief Fields of the board.
+ *
+ * Fields are numbered row after row with one more field in every row
+ * and one more row below and above the board. These fields are border
+ * owned by BORDER_OWNER, so every field of the board has four nearby
+ * fields at fixed distance.
+ *
+ * Dense board keeps all Nodes in one anonymous mapping, whose pages are
+ * taken from the system when a move touches them. It remembers chunks
+ * of CHUNK_SIZE fields that were touched, so copying and searching it
+ * skip the rest. Its border is written only next to fields that were
+ * taken, other border fields are zeros, which look like empty fields that
+ * are never taken. Sparse board keeps Nodes in tiles of TILE_SIZE fields
+ * that follow each other in a row, and allocates tile when first field
+ * in it is taken. Fields of missing tiles are empty, so memory of sparse
+ * board grows with number of taken fields.
+ *
+ * File board keeps Nodes in shared mapping of file, in square tiles of
+ * MAPPED_TILE_SIDE fields written one after another, so nearby fields
+ * are on the same pages and board doesn't have to fit in memory.
+ */
+struct board {
+    Node *nodes;                /**< Array of all Nodes or NULL if board
+                                     isn't dense */
+    uint64_t *touched;          /**< Bitmap of chunks of dense board that
+                                     may have other Nodes than zeros */
+    uint64_t size;              /**< Number of fields with border */
+    uint64_t width;             /**< Game width */
+    uint64_t height;            /**< Game height */
+    uint64_t stride;            /**< Distance between rows */
+
+    tile *tiles;                /**< Hash map of allocated tiles */
+    uint64_t tilesSize;         /**< Number of allocated tiles */
+    uint64_t tilesCapacity;     /**< Number of slots in tiles, power of 2 */
+    Node empty;                 /**< Node of every field of missing tile,
+                                     never changed */
+    Node border;                /**< Node of every field of border that
+                                     isn't kept in memory, never changed */
+
+    Node *mapped;               /**< Mapped tiles of file board or NULL */
+    uint64_t mappedSize;        /**< Number of Nodes in mapped tiles */
+    char *head;                 /**< Mapped beginning of file before tiles */
+    uint64_t headSize;          /**< Number of bytes before tiles */
+    uint64_t tilesInRow;        /**< Number of tiles in row of file board */
+    int file;                   /**< Descriptor of file of file board */
+};
+
+/**
+ * Fields of the board.
+ */
+typedef struct board Board;
+
+/** @brief Gives number of fields of board with border.
+ * @param width - game width
+ * @param height - game height
+ * @return number of fields with border
+ */
+static inline uint64_t boardSize(uint64_t width, uint64_t height) {
+    return (height + 2) * (width + 1);
+}
+
+/** @brief Makes dense board of empty fields.
+ * Doesn't touch fields, so it takes constant time. Border is written by
+ * touchNode() next to fields that are taken.
+ * @param b - memory for board
+ * @param width - game width
+ * @param height - game height
+ * @return false if there was not enough memory else true
+ */
+bool initDenseBoard(Board *b, uint32_t width, uint32_t height);
+
+/** @brief Writes whole border of dense board.
+ * Marks all chunks as touched, so it's used when all pages of board are
+ * written anyway.
+ * @param b - dense board
+ */
+void writeBorder(Board *b);
+
+/** @brief Makes sparse board of empty fields.
+ * @param b - memory for board
+ * @param width - game width
+ * @param height - game height
+ * @return false if there was not enough memory else true
+ */
+bool initSparseBoard(Board *b, uint32_t width, uint32_t height);
+
+/** @brief Makes file board.
+ * Tiles are mapped from @p offset of file, which is made with empty
+ * fields if @p create is true and has to already keep them else. Bytes
+ * before tiles are mapped as well, as head of board.
+ * @param b - memory for board
+ * @param width - game width
+ * @param height - game height
+ * @param path - path of file
+ * @param offset - offset of tiles in file, divisible by size of page
+ * @param create - if file should be made again
+ * @return false if file couldn't be opened or mapped else true
+ */
+bool initFileBoard(Board *b, uint32_t width, uint32_t height,
+                   const char *path, uint64_t offset, bool create);
+
+/** @brief Writes changed Nodes and head of file board to its file.
+ * @param b - file board
+ * @return true if Nodes were written else false
+ */
+bool syncBoard(Board *b);
+
+/** @brief Frees memory of board.
+ * @param b - board
+ */
+void freeBoard(Board *b);
+
+/** @brief Copies board.
+ * Copy of file board is dense and needs memory only for pages with
+ * fields that aren't empty, but whole file is read.
+ * @param copy - memory for copy
+ * @param b - copied board
+ * @return false if there was not enough memory else true
+ */
+bool copyBoard(Board *copy, const Board *b);
+
+/** @brief Gives Node of field from sparse board.
+ * @param b - sparse board
+ * @param elem - index of field
+ * @return Node of field or shared empty or border Node if its tile is
+ * missing
+ */
+Node *sparseNode(Board *b, cell_t elem);
+
+/** @brief Makes sure that Node of field can be changed.
+ * Allocates tile of field on sparse board if it is missing and writes
+ * border next to field on dense board.
+ * @param b - board
+ * @param elem - index of field
+ * @return false if there was not enough memory else true
+ */
+bool touchNode(Board *b, cell_t elem);
+
+/** @brief Checks if field is part of border.
+ * @param b - board
+ * @param elem - index of field
+ * @return true if field is part of border else false
+ */
+static inline bool isBorder(const Board *b, cell_t elem) {
+    return elem < b->stride || elem >= b->size - b->stride ||
+           elem % b->stride == 0;
+}
+
+/** @brief Gives position of Node of field in tiles of file board.
+ * @param b - file board
+ * @param elem - index of field that isn't part of border
+ * @return index of Node in mapped tiles
+ */
+static inline uint64_t mappedIndex(const Board *b, cell_t elem) {
+    uint64_t x = elem % b->stride - 1;
+    uint64_t y = elem / b->stride - 1;
+    uint64_t mask = MAPPED_TILE_SIDE - 1;
+    uint64_t tile = (y >> MAPPED_TILE_BITS) * b->tilesInRow +
+                    (x >> MAPPED_TILE_BITS);
+
+    return tile << (2u * MAPPED_TILE_BITS) |
+           (y & mask) << MAPPED_TILE_BITS | (x & mask);
+}
+
+/** @brief Gives Nodes of fields that follow field in memory.
+ * Fields of dense and sparse board may be followed by border.
+ * @param b - board
+ * @param elem - index of field that isn't part of border
+ * @param count - memory for number of fields from @p elem to the end
+ * of its tile or board
+ * @return Nodes from @p elem or NULL if they are all empty and missing
+ */
+const Node *nodesFrom(const Board *b, cell_t elem, uint64_t *count);
+
+/** @brief Gives next Nodes that are kept in memory.
+ * Dense board has one range for every touched chunk, sparse board for
+ * every allocated tile and file board for every row of every tile, in any
+ * order.
+ * Ranges of dense and sparse board contain border.
+ * @param b - board
+ * @param position - position of search, 0 at the beginning
+ * @param first - memory for index of first field of range
+ * @param count - memory for number of fields in range
+ * @return Nodes of range or NULL if there are no more ranges
+ */
+Node *nextNodes(Board *b, uint64_t *position, cell_t *first, uint64_t *count);
+
+/** @brief Gives Node of field.
+ * Node of field of missing tile can only be read.
+ * @param b - board
+ * @param elem - index of field
+ * @return Node of field
+ */
+static inline Node *nodeAt(Board *b, cell_t elem) {
+    if (b->nodes != NULL)
+        return &b->nodes[elem];
+    if (b->mapped != NULL)
+        return isBorder(b, elem) ? &b->border :
+               &b->mapped[mappedIndex(b, elem)];
+
+    return sparseNode(b, elem);
+}
+
+#endif //GAMMA_BOARD_H
@@ -5,71 +5,85 @@
  */
 
 #include "findUnion.h"
+#include "../boardLib/board.h"
 
 
-Node *newRoot(uint32_t player, uint32_t x, uint32_t y) {
-    Node *output = (Node *) malloc(sizeof(Node));
-    if (output == NULL)
-        return NULL;
-
-    *output = (Node) {x, y, false, player, 0, output};
-
-    return output;
+void initRoot(Board *board, cell_t elem, uint32_t player) {
+    *nodeAt(board, elem) = (Node) {player, 0, 0, 0, false};
 }
 
-inline bool isRootAdded(Node *elem) {
-    return find(elem)->added;
+inline bool isRootAdded(Board *board, cell_t elem) {
+    return nodeAt(board, findRoot(board, elem))->added;
 }
 
-void setRootAdded(Node *elem, bool state) {
-    if (elem == NULL)
+void setRootAdded(Board *board, cell_t elem, bool state) {
+    if (elem == NO_CELL)
         return;
-    find(elem)->added = state;
+    nodeAt(board, findRoot(board, elem))->added = state;
 }
 
-Node *find(Node *elem) {
-    if (elem == NULL)
-        return NULL;
+cell_t findRoot(Board *board, cell_t elem) {
+    if (elem == NO_CELL)
+        return NO_CELL;
 
-    while (elem->parent != elem) {
-        elem->parent = find(elem->parent);
-        elem = elem->parent;
-    }
+    cell_t parent;
+    while ((parent = parentOf(nodeAt(board, elem), elem)) != elem)
+        elem = parent;
 
     return elem;
 }
 
-bool sameRoot(Node *a, Node *b) {
-    if (a == NULL || b == NULL)
+cell_t find(Board *board, cell_t elem) {
+    if (elem == NO_CELL)
+        return NO_CELL;
+
+    cell_t root = findRoot(board, elem);
+
+    // path compression
+    while (elem != root) {
+        Node *node = nodeAt(board, elem);
+        cell_t next = parentOf(node, elem);
+        setParent(node, elem, root);
+        elem = next;
+    }
+
+    return root;
+}
+
+bool sameRoot(Board *board, cell_t a, cell_t b) {
+    if (a == NO_CELL || b == NO_CELL)
         return false;
     else
-        return find(a) == find(b);
+        return findRoot(board, a) == findRoot(board, b);
 }
 
-Node *merge(Node *a, Node *b) {
-    Node *aRoot = find(a);
-    Node *bRoot = find(b);
+cell_t merge(Board *board, cell_t a, cell_t b) {
+    cell_t aRoot = findRoot(board, a);
+    cell_t bRoot = findRoot(board, b);
 
     if (aRoot == bRoot)
         return aRoot;
 
+    Node *aNode = nodeAt(board, aRoot);
+    Node *bNode = nodeAt(board, bRoot);
 
-    if (aRoot->rank >= bRoot->rank) {
-        bRoot->parent = aRoot;
-        aRoot->rank++;
+    if (aNode->rank >= bNode->rank) {
+        setParent(bNode, bRoot, aRoot);
+        if (aNode->rank == bNode->rank)
+            aNode->rank++;
         return aRoot;
     }
     else {
-        aRoot->parent = bRoot;
-        bRoot->rank++;
+        setParent(aNode, aRoot, bRoot);
         return bRoot;
     }
 }
 
-void clearNodeData(Node *elem) {
-    if (elem == NULL)
+void clearNodeData(Board *board, cell_t elem) {
+    if (elem == NO_CELL)
         return;
 
-    elem->parent = elem;
-    elem->rank = 0;
+    Node *node = nodeAt(board, elem);
+    setParent(node, elem, elem);
+    node->rank = 0;
 }
@@ -11,76 +11,129 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+/**
+ * Index of field in array of Nodes.
+ */
+typedef uint64_t cell_t;
+
+/**
+ * Index used when there is no field.
+ */
+#define NO_CELL UINT64_MAX
+
+/**
+ * Maximal number of fields, so that every parent fits in 48 bits.
+ */
+#define CELLS_LIMIT ((UINT64_C(1) << 48u) - 1)
+
 /**
  * Field data.
  */
 typedef struct Node Node;
 
+/**
+ * Fields of the board.
+ */
+typedef struct board Board;
+
 /** @brief Structure that holds field data.
  *
- * Able to perform find and union.
+ * Able to perform find and union. Nodes refer to each other by index.
+ * Index of parent is kept plus one in 48 bits, so that Node made
+ * of zeros is an empty root.
  */
 struct Node {
-    uint32_t x,             /**< First coordinate */
-    y;                      /**< Second coordinate */
-
-    bool added;             /**< State of Node */
     uint32_t owner;         /**< Id of owner */
-    uint32_t rank;          /**< Number of merges to this Node */
-
-    Node *parent;           /**< Parent Node */
+    uint32_t parentLow;     /**< Lower 32 bits of parent plus one,
+                                 0 for root */
+    uint16_t parentHigh;    /**< Higher 16 bits of parent plus one */
+    uint8_t rank;           /**< Upper bound on height of Node's tree */
+    bool added;             /**< State of Node */
 };
 
-/** @brief Creates new root.
- * Creates root owned by @p player at coords (@p x, @p y)
+/** @brief Gives parent of Node.
+ * @param node - Node of field
+ * @param elem - index of @p node
+ * @return index of parent of @p node
+ */
+static inline cell_t parentOf(const Node *node, cell_t elem) {
+    uint64_t parent = ((uint64_t) node->parentHigh << 32u) | node->parentLow;
+    return parent == 0 ? elem : parent - 1;
+}
+
+/** @brief Changes parent of Node.
+ * @param node - Node of field
+ * @param elem - index of @p node
+ * @param parent - index of new parent
+ */
+static inline void setParent(Node *node, cell_t elem, cell_t parent) {
+    uint64_t stored = parent == elem ? 0 : parent + 1;
+    node->parentLow = (uint32_t) stored;
+    node->parentHigh = (uint16_t) (stored >> 32u);
+}
+
+/** @brief Initializes new root.
+ * Makes Node @p elem a root owned by @p player
+ * @param board - board
+ * @param elem - index of Node being initialized
  * @param player - new owner
- * @param x - first coordinate
- * @param y - second coordinate
- * @return Pointer to new root
  */
-Node *newRoot(uint32_t player, uint32_t x, uint32_t y);
+void initRoot(Board *board, cell_t elem, uint32_t player);
 
 /** @brief Check if @p elem root is Added.
- * @param elem - Node being checked
+ * @param board - board
+ * @param elem - index of Node being checked
  * @return true if @p elem root is added else false
  */
-bool isRootAdded(Node *elem);
+bool isRootAdded(Board *board, cell_t elem);
 
 /** @brief Set @p elem added.
  * Changes @p elem root added to @p state
- * @param elem - Son of root being changed
+ * @param board - board
+ * @param elem - index of son of root being changed
  * @param state - new state
  */
-void setRootAdded(Node *elem, bool state);
+void setRootAdded(Board *board, cell_t elem, bool state);
 
 /** @brief Returns root of Node.
  * Return root of @p elem and performs path compression
- * @param elem - Root's son
- * @return NULL if @p elem is NULL else @p elem's root
+ * @param board - board
+ * @param elem - index of Root's son
+ * @return NO_CELL if @p elem is NO_CELL else index of @p elem's root
  */
-Node *find(Node *elem);
+cell_t find(Board *board, cell_t elem);
+
+/** @brief Returns root of Node without changing Nodes.
+ * Other functions use it, so that only find() shortens paths.
+ * @param board - board
+ * @param elem - index of Root's son
+ * @return NO_CELL if @p elem is NO_CELL else index of @p elem's root
+ */
+cell_t findRoot(Board *board, cell_t elem);
 
 /** @brief Check if nodes have same root.
  * Check if node @p a and @p b have same root
- * @param a - first Node
- * @param b - second Node
- * @return true if @p a and @p b are not NULL and have same root else false
+ * @param board - board
+ * @param a - index of first Node
+ * @param b - index of second Node
+ * @return true if @p a and @p b are not NO_CELL and have same root else false
  */
-bool sameRoot(Node *a, Node *b);
+bool sameRoot(Board *board, cell_t a, cell_t b);
 
 /** @brief Merge two roots.
- * Merge @p a and @p b roots, performs path compression
- * @param a - first Node
- * @param b - second Node
- * @return Root of merged nodes
+ * Merge @p a and @p b roots by rank
+ * @param board - board
+ * @param a - index of first Node
+ * @param b - index of second Node
+ * @return index of root of merged nodes
  */
-Node *merge(Node *a, Node *b);
+cell_t merge(Board *board, cell_t a, cell_t b);
 
 /** @brief Clears temporary data.
  * Removes connection with other Nodes
- *
- * @param elem - Node to clear data
+ * @param board - board
+ * @param elem - index of Node to clear data
  */
-void clearNodeData(Node *elem);
+void clearNodeData(Board *board, cell_t elem);
 
 #endif //GAMMA_FINDUNION_H
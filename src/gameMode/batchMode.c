@@ -13,68 +13,188 @@
 #include <string.h>
 #include <inttypes.h>
 
+/**
+ * Number of moves passed to engine at once by multi-move commands
+ */
+#define MOVES_CHUNK 1024
+
 /**
  * Current gamma game
  */
-gamma_t *game;
+static gamma_t *game;
+
+/** @brief Makes moves of player on rectangle.
+ * Moves row by row on fields with coordinates between given ones,
+ * skipping fields outside the board.
+ * @param values - player and coordinates of two opposite corners
+ * @return number of moves made
+ */
+static uint64_t moveRectangle(uint32_t values[]);
+
+/** @brief Makes moves of player on row.
+ * Moves on fields from (x, y) to the right, skipping fields outside
+ * the board.
+ * @param values - player, x, y and number of fields
+ * @return number of moves made
+ */
+static uint64_t moveRow(uint32_t values[]);
+
+/** @brief Makes moves of player on listed fields.
+ * Reads player and pairs of coordinates from @p str and moves on every
+ * field in given order. Nothing is moved if line is not correct.
+ * @param str - first char after command
+ * @param end - char after the last one
+ * @param made - number of moves made
+ * @return true if line was correct else false
+ */
+static bool moveList(const char *str, const char *end, uint64_t *made);
 
 /** @brief Plays game in Batch Mode
  * Reads lines and prints results.
  */
 static void gameLoop();
 
+static uint64_t moveRectangle(uint32_t values[]) {
+    uint32_t fromX = values[1] < values[3] ? values[1] : values[3];
+    uint32_t toX = values[1] < values[3] ? values[3] : values[1];
+    uint32_t fromY = values[2] < values[4] ? values[2] : values[4];
+    uint32_t toY = values[2] < values[4] ? values[4] : values[2];
+
+    if (toX >= gamma_get_width(game))
+        toX = gamma_get_width(game) - 1;
+    if (toY >= gamma_get_height(game))
+        toY = gamma_get_height(game) - 1;
+
+    move_t moves[MOVES_CHUNK];
+    size_t size = 0;
+    uint64_t made = 0;
+
+    for (uint64_t y = fromY; y <= toY; y++) {
+        for (uint64_t x = fromX; x <= toX; x++) {
+            moves[size++] = (move_t) {values[0], x, y};
+
+            if (size == MOVES_CHUNK) {
+                made += gamma_move_batch(game, moves, size, NULL);
+                size = 0;
+            }
+        }
+    }
+
+    return made + gamma_move_batch(game, moves, size, NULL);
+}
+
+static uint64_t moveRow(uint32_t values[]) {
+    uint32_t width = gamma_get_width(game);
+    if (values[3] == 0 || values[1] >= width)
+        return 0;
+
+    uint32_t toX = values[3] - 1 < width - 1 - values[1] ?
+                   values[1] + values[3] - 1 : width - 1;
+    uint32_t rectangle[5] = {values[0], values[1], values[2], toX, values[2]};
+
+    return moveRectangle(rectangle);
+}
+
+static bool moveList(const char *str, const char *end, uint64_t *made) {
+    // check whole line before moving
+    int64_t numbers = countNumbers(str, end);
+    if (numbers < 3 || numbers % 2 == 0)
+        return false;
+
+    uint32_t player;
+    readNumber(&player, &str, end);
+
+    move_t moves[MOVES_CHUNK];
+    size_t size = 0;
+    *made = 0;
+
+    for (int64_t i = 0; i < numbers / 2; i++) {
+        moves[size].player = player;
+        readNumber(&moves[size].x, &str, end);
+        readNumber(&moves[size].y, &str, end);
+
+        if (++size == MOVES_CHUNK) {
+            *made += gamma_move_batch(game, moves, size, NULL);
+            size = 0;
+        }
+    }
+
+    *made += gamma_move_batch(game, moves, size, NULL);
+    return true;
+}
+
 
 static void gameLoop() {
-    char *line;
-    uint32_t values[4];
+    char *line, *end;
+    uint32_t values[5];
 
-    while (giveLine(&line)) {
+    while (giveLine(&line, &end)) {
+        char command = line == end ? '\0' : line[0];
 
         // comment or new line
-        if (line[0] == '#' || line[0] == '\n') {
-            free(line);
+        if (command == '#' || command == '\n')
             continue;
-        }
 
 
-        if (line[0] == 'm') {
-            if (readNumbers(values, line + 1, 3))
+        if (command == 'm') {
+            if (readNumbers(values, line + 1, end, 3))
                 printf("%d\n",
                        gamma_move(game, values[0], values[1], values[2]));
             else
                 errorMessage();
         }
-        else if (line[0] == 'g') {
-            if (readNumbers(values, line + 1, 3))
+        else if (command == 'g') {
+            if (readNumbers(values, line + 1, end, 3))
                 printf("%d\n",
                        gamma_golden_move(game, values[0], values[1], values[2]));
             else
                 errorMessage();
         }
-        else if (line[0] == 'b') {
-            if (readNumbers(values, line + 1, 1))
+        else if (command == 'b') {
+            if (readNumbers(values, line + 1, end, 1))
                 printf("%"PRIu64"\n",
                        gamma_busy_fields(game, values[0]));
             else
                 errorMessage();
         }
-        else if (line[0] == 'f') {
-            if (readNumbers(values, line + 1, 1))
+        else if (command == 'f') {
+            if (readNumbers(values, line + 1, end, 1))
                 printf("%"PRIu64"\n",
                        gamma_free_fields(game, values[0]));
             else
                 errorMessage();
         }
-        else if (line[0] == 'q') {
-            if (readNumbers(values, line + 1, 1))
+        else if (command == 'q') {
+            if (readNumbers(values, line + 1, end, 1))
                 printf("%d\n",
                        gamma_golden_possible(game, values[0]));
             else
                 errorMessage();
         }
-        else if (line[0] == 'p') {
-            if (readNumbers(values, line + 1, 0))
-                textMessage(gamma_board(game));
+        else if (command == 'r') {
+            if (readNumbers(values, line + 1, end, 5))
+                printf("%"PRIu64"\n", moveRectangle(values));
+            else
+                errorMessage();
+        }
+        else if (command == 'w') {
+            if (readNumbers(values, line + 1, end, 4))
+                printf("%"PRIu64"\n", moveRow(values));
+            else
+                errorMessage();
+        }
+        else if (command == 'l') {
+            uint64_t made;
+            if (moveList(line + 1, end, &made))
+                printf("%"PRIu64"\n", made);
+            else
+                errorMessage();
+        }
+        else if (command == 'p') {
+            if (readNumbers(values, line + 1, end, 0)) {
+                gamma_board_write(game, stdout);
+                fflush(stdout);
+            }
             else
                 errorMessage();
         }
@@ -82,9 +202,11 @@ static void gameLoop() {
             errorMessage();
 
 
-        free(line);
-        fflush(stdout);
+        if (!isOutputBuffered())
+            fflush(stdout);
     }
+
+    fflush(stdout);
 }
 
 bool initializeBatch(uint32_t values[]) {
@@ -0,0 +1,127 @@
+/** @file
+ * Binary mode implementation
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+#include "binaryMode.h"
+#include "../gamma.h"
+#include "../inputParser/parser.h"
+
+#include <stdio.h>
+
+/**
+ * Size of command record in bytes
+ */
+#define RECORD_SIZE 16
+
+/**
+ * Size of result in bytes
+ */
+#define RESULT_SIZE 8
+
+/**
+ * Result of unknown command
+ */
+#define WRONG_COMMAND UINT64_MAX
+
+/**
+ * Current gamma game
+ */
+static gamma_t *game;
+
+/** @brief Reads little-endian number.
+ * @param bytes - 4 bytes of number
+ * @return read number
+ */
+static uint32_t readUint32(const char *bytes);
+
+/** @brief Writes little-endian result.
+ * @param result - written result
+ */
+static void writeResult(uint64_t result);
+
+/** @brief Executes single command.
+ * @param record - command record
+ */
+static void processRecord(const char *record);
+
+/** @brief Plays game in Binary Mode
+ * Reads records and writes results.
+ */
+static void gameLoop();
+
+
+static uint32_t readUint32(const char *bytes) {
+    const unsigned char *b = (const unsigned char *) bytes;
+
+    return (uint32_t) b[0] | (uint32_t) b[1] << 8u |
+           (uint32_t) b[2] << 16u | (uint32_t) b[3] << 24u;
+}
+
+static void writeResult(uint64_t result) {
+    unsigned char bytes[RESULT_SIZE];
+
+    for (int i = 0; i < RESULT_SIZE; i++)
+        bytes[i] = (unsigned char) (result >> (8u * i));
+
+    fwrite(bytes, 1, RESULT_SIZE, stdout);
+}
+
+static void processRecord(const char *record) {
+    uint32_t command = readUint32(record);
+    uint32_t player = readUint32(record + 4);
+    uint32_t x = readUint32(record + 8);
+    uint32_t y = readUint32(record + 12);
+
+    if (command == 'm')
+        writeResult(gamma_move(game, player, x, y));
+    else if (command == 'g')
+        writeResult(gamma_golden_move(game, player, x, y));
+    else if (command == 'b')
+        writeResult(gamma_busy_fields(game, player));
+    else if (command == 'f')
+        writeResult(gamma_free_fields(game, player));
+    else if (command == 'q')
+        writeResult(gamma_golden_possible(game, player));
+    else if (command == 'p') {
+        writeResult(gamma_board_length(game));
+        gamma_board_write(game, stdout);
+    }
+    else
+        writeResult(WRONG_COMMAND);
+}
+
+static void gameLoop() {
+    char *record;
+
+    while (true) {
+        // results are sent before waiting for more commands
+        if (bufferedBytes() < RECORD_SIZE)
+            fflush(stdout);
+
+        if (!giveBytes(&record, RECORD_SIZE)) {
+            // truncated input is told apart from its clean end
+            if (bufferedBytes() > 0)
+                writeResult(WRONG_COMMAND);
+            break;
+        }
+
+        processRecord(record);
+    }
+
+    fflush(stdout);
+}
+
+bool initializeBinary(uint32_t values[]) {
+    game = gamma_new(values[0], values[1], values[2], values[3]);
+
+    if (game == NULL)
+        return false;
+
+    okMessage();
+    gameLoop();
+
+    gamma_delete(game);
+    return true;
+}
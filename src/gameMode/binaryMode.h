@@ -0,0 +1,26 @@
+/** @file
+ * Binary mode interface
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+#ifndef GAMMA_BINARYMODE_H
+#define GAMMA_BINARYMODE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Initialize game in Binary mode.
+ * Creates new game and allow to play it in Binary mode.
+ * Commands are records of four 32-bit little-endian numbers: command letter
+ * used in Batch mode, player, first and second coordinate. Every record
+ * gets 64-bit little-endian result: 0 or 1 for 'm', 'g' and 'q', number of
+ * fields for 'b' and 'f', length of board for 'p' followed by the board,
+ * and UINT64_MAX for unknown command. Incomplete record at the end of
+ * input gets UINT64_MAX too.
+ * @param values - array of values needed to initialize gamma game
+ * @return true if game was played else false
+ */
+bool initializeBinary(uint32_t values[]);
+
+#endif //GAMMA_BINARYMODE_H
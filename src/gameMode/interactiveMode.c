@@ -26,7 +26,7 @@
 /**
  * Current gamma game
  */
-gamma_t *game;
+static gamma_t *game;
 
 /** First coordinate of special field */
 uint32_t posX;
@@ -56,6 +56,13 @@ static uint32_t processChar(char ch, uint32_t id);
  */
 static uint32_t fieldLength(uint32_t players);
 
+/** @brief Prints field.
+ * Prints field at (@p x, @p y) at the current cursor position.
+ * @param x - first coordinate
+ * @param y - second coordinate
+ */
+static void printField(uint32_t x, uint32_t y);
+
 /** @brief Plays game in Interactive Mode
  * Read characters and prints results.
  */
@@ -143,6 +150,13 @@ static uint32_t fieldLength(uint32_t players) {
     return numberLength;
 }
 
+static void printField(uint32_t x, uint32_t y) {
+    char field[32] = "";
+
+    gamma_field_into(game, x, y, field);
+    printf("%s", field);
+}
+
 static void gameLoop() {
     uint32_t id = 1;
     uint32_t fl = gamma_field_length(game);
@@ -156,7 +170,7 @@ static void gameLoop() {
     printf("\e[%"PRIu32";%"PRIu32"H", gamma_get_height(game) - posY,
            fl * posX + 1);
     BACKGROUND_WHITE;
-    textMessage(gamma_update_field(game, posX, posY));
+    printField(posX, posY);
     printf("\e[%"PRIu32";%"PRIu32"H", gamma_get_height(game) - posY,
            fl * posX + 1);
 
@@ -169,14 +183,14 @@ static void gameLoop() {
 
         // remove background color on previous field
         COLOR_RESET;
-        textMessage(gamma_update_field(game, previousX, previousY));
+        printField(previousX, previousY);
 
         // cursor to beginning of current field
         printf("\e[%"PRIu32";%"PRIu32"H", gamma_get_height(game) - posY,
                fl * posX + 1);
 
         BACKGROUND_WHITE;
-        textMessage(gamma_update_field(game, posX, posY));
+        printField(posX, posY);
         COLOR_RESET;
 
         // remove last line
@@ -190,7 +204,7 @@ static void gameLoop() {
     }
 
     COLOR_RESET;
-    textMessage(gamma_update_field(game, posX, posY));
+    printField(posX, posY);
 
     // enable cursor
     printf("\e[?25h");
@@ -5,23 +5,55 @@
  */
 
 #include "gammaLib/gammaEngineLib.h"
+#include "gammaLib/gameFile.h"
+#include "gammaLib/boardImport.h"
 #include "gamma.h"
 #include <stdio.h>
-#include <string.h>
 #include <inttypes.h>
+#include <string.h>
 
 /**
  * Maximal number of golden moves of one player
  */
 #define NUM_GOLDEN_MOVES 1
 
+/**
+ * Size of buffer used to write board to file
+ */
+#define WRITE_BUFFER_SIZE 65536
+
 
-/** @brief Free @p g, @p members, @p board.
+/** @brief Free @p g, @p members, @p board, @p digits.
  * @param g - current game
- * @param members - array of players
- * @param board - game board
+ * @param members - array of players, zeroed or initialized
+ * @param players - number of players in @p members
+ * @param board - game board, zeroed or initialized
+ * @param digits - printed fields of first ids
  */
-static void freeData(gamma_t *g, Member *members, Node ***board);
+static void freeData(gamma_t *g, member *members, uint32_t players,
+                     Board *board, char *digits);
+
+/** @brief Checks parameters of new game.
+ * @param width - game width
+ * @param height - game height
+ * @param players - number of players
+ * @param areas - maximal number of areas
+ * @return true if game with such parameters can be made else false
+ */
+static bool correctParameters(uint32_t width, uint32_t height,
+                              uint32_t players, uint32_t areas);
+
+/** @brief Creates new game with given board.
+ * Game takes @p board, which is freed if game can't be made.
+ * @param width - game width
+ * @param height - game height
+ * @param players - number of players
+ * @param areas - maximal number of areas
+ * @param board - board of empty fields made for correct parameters
+ * @return new game or NULL if there was not enough memory
+ */
+static gamma_t *newGame(uint32_t width, uint32_t height,
+                        uint32_t players, uint32_t areas, Board *board);
 
 /** @brief Do quick check if golden move can be done.
  *  Checks if attacking player has maximal amount of areas and doesn't have
@@ -57,12 +89,86 @@ static void goldenMovePrep(gamma_t *g, Member attackedPlayer,
 static bool goldenMoveFinish(gamma_t *g, Member attackedPlayer, uint32_t player,
                              uint32_t x, uint32_t y);
 
+/** @brief Takes empty field.
+ * Performs move of @p player on empty field (@p x, @p y) if it doesn't
+ * make too many areas. Arguments have to be correct.
+ * @param g - current game
+ * @param player - Member's id
+ * @param x - first coordinate
+ * @param y - second coordinate
+ * @return true if move was made else false
+ */
+static bool moveOnField(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
+
+/** @brief Remembers everything that move on empty field can change.
+ * Remembers the field, roots of nearby areas of @p player and counters
+ * of players owning nearby fields. Space has to be reserved before.
+ * @param g - current game
+ * @param player - Member's id
+ * @param x - first coordinate
+ * @param y - second coordinate
+ */
+static void journalMove(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
+
+/** @brief Prefetches field of move.
+ * @param g - current game
+ * @param move - move that will be made soon
+ */
+static void prefetchMove(gamma_t *g, const move_t *move);
+
+/** @brief Check if golden move can be done without doing it.
+ * Field @p elem has to belong to other player. Counts areas of attacked
+ * player split by @p elem only if it can't be avoided. Doesn't change
+ * the board.
+ * @param g - current game
+ * @param s - search memory
+ * @param player - attacking player
+ * @param elem - index of attacked field
+ * @return true if golden move can be done else false
+ */
+static bool goldenMoveLegal(gamma_t *g, Search *s, uint32_t player,
+                            cell_t elem);
+
+/** @brief Check if losing field is legal without looking at areas.
+ * Owner of field @p elem can lose it if it can't get more areas than
+ * allowed even if all its nearby fields become separate areas.
+ * @param g - current game
+ * @param elem - index of attacked field
+ * @return true if owner can surely lose @p elem else false
+ */
+static bool canGoldTrivially(gamma_t *g, cell_t elem);
+
+/** @brief Looks for golden move among all fields.
+ * @param g - current game
+ * @param player - attacking player
+ * @return true if golden move can be done else false
+ */
+static bool goldenPossibleScan(gamma_t *g, uint32_t player);
+
+/** @brief Looks for golden move among candidates of player.
+ * Removes candidates that are outdated and watches owners of the others.
+ * @param g - current game
+ * @param player - attacking player
+ * @return true if golden move can be done else false
+ */
+static bool goldenPossibleCandidates(gamma_t *g, uint32_t player);
+
+/** @brief Frees game without writing file board to its file.
+ * @param g - game, may be rejected while being opened
+ */
+static void freeGame(gamma_t *g);
+
 // ----------------------------------------------------------------------------
 
-static void freeData(gamma_t *g, Member *members, Node ***board) {
+static void freeData(gamma_t *g, member *members, uint32_t players,
+                     Board *board, char *digits) {
+    for (uint32_t i = 0; members != NULL && i < players; i++)
+        clearMember(&members[i]);
+
     free(g);
     free(members);
-    free(board);
+    freeBoard(board);
+    free(digits);
 }
 
 static bool canGoldFastCheck(gamma_t *g, uint32_t player,
@@ -79,19 +185,32 @@ static void goldenMovePrep(gamma_t *g, Member attackedPlayer,
 
     attackedPlayer->surrounding -= numEmpty(g, attackedPlayer->id, x, y);
 
-    // removes all connections between attackedPlayer's fields
-    clearRelations(g, g->board[x][y], attackedPlayer->id);
+    cell_t elem = getCell(g, x, y);
+
+    // look for nearby fields meeting again around (x, y)
+    if (searchSplit(g, &g->search, attackedPlayer->id, elem) &&
+        relabelSplit(g, &g->search, elem)) {
+
+        resetField(g, attackedPlayer->id, x, y);
+        getField(g, x, y)->added = false;
 
-    // change owner to 0
-    resetField(g, attackedPlayer->id, x, y);
+        attackedPlayer->areas += g->search.areas - 1;
+    }
+    else {
+        // removes all connections between attackedPlayer's fields
+        clearRelations(g, elem, attackedPlayer->id);
 
-    getField(g, x, y)->added = false;
+        // change owner to 0
+        resetField(g, attackedPlayer->id, x, y);
 
-    // builds attacked player's areas but not the middle
-    buildConnected(g, attackedPlayer->id, x, y);
+        getField(g, x, y)->added = false;
 
-    attackedPlayer->areas +=
-            areasChange(g, attackedPlayer->id, x, y, false);
+        // builds attacked player's areas but not the middle
+        buildConnected(g, attackedPlayer->id, x, y);
+
+        attackedPlayer->areas +=
+                areasChange(g, attackedPlayer->id, x, y, false);
+    }
 
     moveOnEmpty(g, x, y, false);
 }
@@ -103,7 +222,9 @@ static bool goldenMoveFinish(gamma_t *g, Member attackedPlayer, uint32_t player,
         if (gamma_move(g, player, x, y)) {
 
             // made golden_move
-            getPlayer(g, player)->goldenMoves++;
+            useGoldenMove(g, player);
+            storeMember(g, player);
+            attackedPlayer->changed = g->moves;
             return true;
         }
         else { // cant move
@@ -119,63 +240,393 @@ static bool goldenMoveFinish(gamma_t *g, Member attackedPlayer, uint32_t player,
     }
 }
 
+static bool moveOnField(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    if (!reserveJournal(&g->journal, JOURNAL_MOVE_CELLS, JOURNAL_MOVE_MEMBERS)
+        || !touchNode(&g->board, getCell(g, x, y)))
+        return false;
+
+    // new area
+    if (numNeighbours(g, player, x, y) == 0) {
+        if (getAreas(g, player) == g->areas) {
+            return false;
+        }
+
+        journalMove(g, player, x, y);
+        takeField(g, player, x, y);
+        getPlayer(g, player)->areas++;
+
+    }
+    else {
+        journalMove(g, player, x, y);
+        takeField(g, player, x, y);
+        getPlayer(g, player)->areas -= areasChange(g, player, x, y, true);
+    }
+
+    getPlayer(g, player)->surrounding += numEmpty(g, player, x, y);
+    moveOnEmpty(g, x, y, true);
+    addCandidates(g, player, x, y);
+    markChanged(g, x, y);
+    return true;
+}
+
+static void journalMove(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    cell_t elem = getCell(g, x, y);
+    cell_t arr[4];
+    nearbyCells(g, arr, elem);
+
+    journalCell(g, elem);
+    journalMember(g, player);
+
+    for (int i = 0; i < 4; i++) {
+        if (nodeAt(&g->board, arr[i])->owner == player)
+            journalCell(g, findRoot(&g->board, arr[i]));
+        journalMember(g, nodeAt(&g->board, arr[i])->owner);
+    }
+}
+
+static void prefetchMove(gamma_t *g, const move_t *move) {
+    if (!wrongCoordinates(g, move->x, move->y))
+        PREFETCH(getField(g, move->x, move->y));
+}
+
+static bool goldenMoveLegal(gamma_t *g, Search *s, uint32_t player,
+                            cell_t elem) {
+    uint32_t x = fieldX(g, elem);
+    uint32_t y = fieldY(g, elem);
+    uint32_t owner = nodeAt(&g->board, elem)->owner;
+
+    if (!canGoldFastCheck(g, player, x, y))
+        return false;
+    if (canGoldTrivially(g, elem))
+        return true;
+
+    // not enough memory to look at areas
+    if (!searchSplit(g, s, owner, elem))
+        return false;
+
+    return getAreas(g, owner) + s->areas - 1 <= g->areas;
+}
+
+static bool canGoldTrivially(gamma_t *g, cell_t elem) {
+    uint32_t x = fieldX(g, elem);
+    uint32_t y = fieldY(g, elem);
+    uint32_t owner = getOwner(g, x, y);
+    uint32_t nearby = numNeighbours(g, owner, x, y);
+
+    return nearby <= 1 || getAreas(g, owner) + nearby - 1 <= g->areas;
+}
+
+static bool goldenPossibleScan(gamma_t *g, uint32_t player) {
+    uint64_t position = 0;
+    cell_t first;
+    uint64_t count;
+    Node *nodes;
+
+    // fields that aren't kept in memory are empty
+    while ((nodes = nextNodes(&g->board, &position, &first, &count)) != NULL) {
+        for (uint64_t i = 0; i < count; i++) {
+            // border is owned by BORDER_OWNER, which isn't a player
+            if (nodes[i].owner == 0 || nodes[i].owner > g->players ||
+                nodes[i].owner == player)
+                continue;
+
+            cell_t elem = first + i;
+            if (numNeighbours(g, player, fieldX(g, elem), fieldY(g, elem)) > 0
+                && goldenMoveLegal(g, &g->search, player, elem))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+static bool goldenPossibleCandidates(gamma_t *g, uint32_t player) {
+    Member attacking = getPlayer(g, player);
+    uint64_t size = attacking->candidatesSize;
+    uint64_t kept = 0;
+    uint64_t i = 0;
+    bool output = false;
+
+    // outdated candidates may become valid again after rollback
+    bool compact = !g->journal.active;
+
+    for (; i < size && !output; i++) {
+        cell_t elem = attacking->candidates[i];
+        if (!isCandidate(g, player, elem))
+            continue;
+
+        if (compact)
+            attacking->candidates[kept++] = elem;
+        watchOwner(g, player, nodeAt(&g->board, elem)->owner);
+        output = goldenMoveLegal(g, &g->search, player, elem);
+    }
+
+    if (!compact)
+        return output;
+
+    for (; i < size; i++)
+        attacking->candidates[kept++] = attacking->candidates[i];
+    attacking->candidatesSize = kept;
+
+    return output;
+}
+
 //-----------------------------------------------------------------------------
 
+static bool correctParameters(uint32_t width, uint32_t height,
+                              uint32_t players, uint32_t areas) {
+    // every parent has to fit in Node and BORDER_OWNER can't be a player
+    return positive(width) && positive(height) && positive(players) &&
+           positive(areas) && players != BORDER_OWNER &&
+           (uint64_t) width * height <= CELLS_LIMIT &&
+           boardSize(width, height) <= CELLS_LIMIT;
+}
+
+static gamma_t *newGame(uint32_t width, uint32_t height,
+                        uint32_t players, uint32_t areas, Board *board) {
+    uint32_t fieldLength = fieldLengthOf(players);
+    uint32_t digitsSize = players < DIGITS_LIMIT ? players + 1 : DIGITS_LIMIT;
+
+    gamma_t *game = malloc(sizeof(gamma_t));
+    member *members = calloc(players, sizeof(member));
+    char *digits = malloc((size_t) digitsSize * fieldLength);
+
+    if (game == NULL || members == NULL || digits == NULL) {
+        freeData(game, members, 0, board, digits);
+        return NULL;
+    }
+
+    initDigits(digits, digitsSize, fieldLength);
+    initMembers(members, players);
+
+    *game = (gamma_t) {width, height, players, areas,
+                       NUM_GOLDEN_MOVES, (uint64_t) width * height,
+                       members, *board, NULL, 0, {NULL}, 0, 0, 0, {NULL},
+                       fieldLength, digitsSize, digits};
+
+    return game;
+}
+
 gamma_t *gamma_new(uint32_t width, uint32_t height,
                    uint32_t players, uint32_t areas) {
-    if (!positive(width) || !positive(height) || !positive(players)
-        || !positive(areas))
+    if (!correctParameters(width, height, players, areas))
+        return NULL;
+
+    uint64_t size = boardSize(width, height);
+    Board board;
+    bool boardMade = size <= DENSE_LIMIT &&
+                     initDenseBoard(&board, width, height);
+
+    // huge board may not fit in address space, but few moves fit in memory
+    if (!boardMade && size > SPARSE_FALLBACK)
+        boardMade = initSparseBoard(&board, width, height);
+
+    return boardMade ? newGame(width, height, players, areas, &board) : NULL;
+}
+
+gamma_t *gamma_new_sparse(uint32_t width, uint32_t height,
+                          uint32_t players, uint32_t areas) {
+    Board board;
+    if (!correctParameters(width, height, players, areas) ||
+        !initSparseBoard(&board, width, height))
+        return NULL;
+
+    return newGame(width, height, players, areas, &board);
+}
+
+void gamma_delete(gamma_t *g) {
+    if (g == NULL)
+        return;
+
+    // uncommitted moves are discarded before file board is written
+    gamma_rollback(g);
+    syncGame(g);
+    freeGame(g);
+}
+
+static void freeGame(gamma_t *g) {
+    freeBoard(&g->board);
+    free(g->digits);
+    free(g->workList);
+    freeSearch(&g->search);
+    freeJournal(&g->journal);
+
+    for (uint32_t i = 0; i < g->players; i++) {
+        clearMember(getPlayer(g, i + 1));
+    }
+    free(g->members);
+
+    free(g);
+}
+
+gamma_t *gamma_clone(gamma_t *g) {
+    if (g == NULL)
         return NULL;
 
+    Board board;
+    bool boardMade = copyBoard(&board, &g->board);
+
     gamma_t *game = malloc(sizeof(gamma_t));
-    Member *members = malloc(sizeof(member) * players);
-    Node ***board = (Node ***) malloc(width * sizeof(Node **));
+    member *members = calloc(g->players, sizeof(member));
+    char *digits = malloc((size_t) g->digitsSize * g->fieldLength);
 
-    if (game == NULL || members == NULL || board == NULL) {
-        freeData(game, members, board);
+    if (game == NULL || members == NULL || !boardMade || digits == NULL) {
+        freeData(game, members, 0, &board, digits);
         return NULL;
     }
 
-    for (uint32_t i = 0; i < width; i++) {
-        board[i] = (Node **) malloc(height * sizeof(Node *));
-        if (board[i] == NULL) {
-            for (uint32_t j = 0; j < i; j++) // clear previous
-                free(board[j]);
-            freeData(game, members, board);
+    // digits have no pointers inside
+    memcpy(digits, g->digits, (size_t) g->digitsSize * g->fieldLength);
+
+    for (uint32_t i = 0; i < g->players; i++) {
+        if (!copyMember(&members[i], getPlayer(g, i + 1))) {
+            freeData(game, members, i + 1, &board, digits);
             return NULL;
         }
     }
 
-    if (!initBoard(board, width, height) || !initMembers(members, players)) {
-        gamma_delete(game);
+    // buffers are not copied, transaction stays in the original game
+    *game = *g;
+    game->members = members;
+    game->board = board;
+    game->digits = digits;
+    game->workList = NULL;
+    game->workListSize = 0;
+    initSearch(&game->search);
+    initJournal(&game->journal);
+
+    return game;
+}
+
+gamma_t *gamma_import(uint32_t width, uint32_t height, uint32_t players,
+                      uint32_t areas, const uint32_t *owners) {
+    if (owners == NULL)
+        return NULL;
+
+    gamma_t *g = gamma_new(width, height, players, areas);
+    if (g == NULL)
+        return NULL;
+
+    if (!importBoard(g, owners)) {
+        gamma_delete(g);
+        return NULL;
+    }
+
+    return g;
+}
+
+gamma_t *gamma_from_board_text(const char *text, uint32_t players,
+                               uint32_t areas, const uint32_t *goldenUsed) {
+    uint32_t width, height;
+    if (text == NULL || !positive(players) ||
+        !boardTextSize(text, fieldLengthOf(players), &width, &height))
         return NULL;
+
+    gamma_t *g = gamma_new(width, height, players, areas);
+    if (g == NULL)
+        return NULL;
+
+    uint64_t size = (uint64_t) width * (uint64_t) height;
+    uint32_t *owners = size > SIZE_MAX / sizeof(uint32_t) ? NULL :
+                       malloc(size * sizeof(uint32_t));
+    bool correct = owners != NULL &&
+                   parseBoardText(text, g->fieldLength, width, height, owners);
+
+    // golden moves have to be known before candidates are found
+    for (uint32_t i = 0; correct && goldenUsed != NULL && i < players; i++) {
+        correct = goldenUsed[i] <= g->numGoldenMoves;
+        getPlayer(g, i + 1)->goldenMoves = goldenUsed[i];
     }
 
-    *game = (gamma_t) {width, height, players, areas,
-                       NUM_GOLDEN_MOVES, width * height,
-                       members, board};
+    correct = correct && importBoard(g, owners);
+    free(owners);
 
-    return game;
+    if (!correct) {
+        gamma_delete(g);
+        return NULL;
+    }
+
+    return g;
 }
 
-void gamma_delete(gamma_t *g) {
+bool gamma_save(gamma_t *g, FILE *file) {
+    if (g == NULL || file == NULL)
+        return false;
+
+    return writeGame(g, file) && fflush(file) == 0;
+}
+
+gamma_t *gamma_load(FILE *file) {
+    fileHeader header;
+    if (file == NULL || !readHeader(&header, file))
+        return NULL;
+
+    gamma_t *g = gamma_new(header.width, header.height,
+                           header.players, header.areas);
     if (g == NULL)
-        return;
+        return NULL;
+
+    if (!readGame(g, &header, file)) {
+        gamma_delete(g);
+        return NULL;
+    }
 
-    for (uint32_t x = 0; x < g->width; x++) {
-        for (uint32_t y = 0; y < g->height; y++)
-            free(g->board[x][y]);
+    return g;
+}
+
+gamma_t *gamma_new_mapped(uint32_t width, uint32_t height,
+                          uint32_t players, uint32_t areas,
+                          const char *path) {
+    Board board;
+    if (path == NULL || !correctParameters(width, height, players, areas) ||
+        !initFileBoard(&board, width, height, path,
+                       boardOffsetOf(players), true))
+        return NULL;
 
-        free(g->board[x]);
+    gamma_t *g = newGame(width, height, players, areas, &board);
+
+    // file can be opened again from the beginning
+    if (g != NULL && !syncGame(g)) {
+        freeGame(g);
+        return NULL;
     }
-    free(g->board);
 
-    for (uint32_t i = 0; i < g->players; i++) {
-        removeMember(getPlayer(g, i + 1));
+    return g;
+}
+
+gamma_t *gamma_open_mapped(const char *path) {
+    FILE *file = path == NULL ? NULL : fopen(path, "rb");
+    if (file == NULL)
+        return NULL;
+
+    fileHeader header;
+    Board board;
+    gamma_t *g = NULL;
+
+    if (readHeader(&header, file) &&
+        correctParameters(header.width, header.height,
+                          header.players, header.areas) &&
+        initFileBoard(&board, header.width, header.height, path,
+                      header.boardOffset, false))
+        g = newGame(header.width, header.height,
+                    header.players, header.areas, &board);
+
+    // rejected file is left as it was
+    if (g != NULL && !openGame(g, &header, file)) {
+        freeGame(g);
+        g = NULL;
     }
-    free(g->members);
 
-    free(g);
+    fclose(file);
+    return g;
+}
+
+bool gamma_sync(gamma_t *g) {
+    // transaction may still be rolled back
+    if (g == NULL || g->board.mapped == NULL || g->journal.active)
+        return false;
+
+    return syncGame(g);
 }
 
 bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
@@ -184,24 +635,54 @@ bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
         !isEmpty(g, x, y))
         return false;
 
-    // new area
-    if (numNeighbours(g, player, x, y) == 0) {
-        if (getAreas(g, player) == g->areas) {
-            return false;
-        }
+    return moveOnField(g, player, x, y);
+}
 
-        takeField(g, player, x, y);
-        getPlayer(g, player)->areas++;
+size_t gamma_move_batch(gamma_t *g, const move_t *moves, size_t n,
+                        bool *results) {
+    size_t output = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        bool result = false;
 
+        if (g != NULL) {
+            if (i + PREFETCH_DISTANCE < n)
+                prefetchMove(g, &moves[i + PREFETCH_DISTANCE]);
+
+            uint32_t player = moves[i].player;
+            uint32_t x = moves[i].x;
+            uint32_t y = moves[i].y;
+
+            result = positive(player) && player <= g->players &&
+                     !wrongCoordinates(g, x, y) && isEmpty(g, x, y) &&
+                     moveOnField(g, player, x, y);
+        }
+
+        output += result;
+        if (results != NULL)
+            results[i] = result;
     }
-    else {
-        takeField(g, player, x, y);
-        getPlayer(g, player)->areas -= areasChange(g, player, x, y, true);
+
+    return output;
+}
+
+size_t gamma_golden_move_batch(gamma_t *g, const move_t *moves, size_t n,
+                               bool *results) {
+    size_t output = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        if (g != NULL && i + PREFETCH_DISTANCE < n)
+            prefetchMove(g, &moves[i + PREFETCH_DISTANCE]);
+
+        bool result = gamma_golden_move(g, moves[i].player,
+                                        moves[i].x, moves[i].y);
+
+        output += result;
+        if (results != NULL)
+            results[i] = result;
     }
 
-    getPlayer(g, player)->surrounding += numEmpty(g, player, x, y);
-    moveOnEmpty(g, x, y, true);
-    return true;
+    return output;
 }
 
 bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
@@ -212,14 +693,76 @@ bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
 
     Member attackedPlayer = getPlayer(g, getOwner(g, x, y));
 
-    if (!canGoldFastCheck(g, player, x, y))
+    // work list has to hold whole attacked area and journal all its fields
+    if (!canGoldFastCheck(g, player, x, y) ||
+        !reserveWorkList(g, attackedPlayer->owned) ||
+        !reserveJournal(&g->journal,
+                        attackedPlayer->owned + 1 + JOURNAL_MOVE_CELLS,
+                        JOURNAL_GOLDEN_MEMBERS + JOURNAL_MOVE_MEMBERS))
         return false;
 
+    cell_t arr[4];
+    nearbyCells(g, arr, getCell(g, x, y));
+
+    journalMember(g, player);
+    journalMember(g, attackedPlayer->id);
+    for (int i = 0; i < 4; i++)
+        journalMember(g, nodeAt(&g->board, arr[i])->owner);
+
     goldenMovePrep(g, attackedPlayer, x, y);
 
     return goldenMoveFinish(g, attackedPlayer, player, x, y);
 }
 
+bool gamma_golden_move_legal(gamma_t *g, uint32_t player,
+                             uint32_t x, uint32_t y) {
+    if (wrongInput(g, player) || wrongCoordinates(g, x, y) ||
+        isEmpty(g, x, y) || isMine(g, player, x, y) ||
+        !hasGoldenMoves(g, player))
+        return false;
+
+    // own search memory, so that game isn't changed at all
+    Search search;
+    initSearch(&search);
+    bool output = goldenMoveLegal(g, &search, player, getCell(g, x, y));
+    freeSearch(&search);
+
+    return output;
+}
+
+bool gamma_begin(gamma_t *g) {
+    if (g == NULL || g->journal.active)
+        return false;
+
+    g->journal.active = true;
+    g->journal.available = g->available;
+    g->journal.cellsSize = 0;
+    g->journal.membersSize = 0;
+    return true;
+}
+
+bool gamma_rollback(gamma_t *g) {
+    if (g == NULL || !g->journal.active)
+        return false;
+
+    rollbackJournal(g);
+
+    // cached golden moves may come from undone moves
+    g->reverted = ++g->moves;
+    g->journal.active = false;
+    return true;
+}
+
+bool gamma_commit(gamma_t *g) {
+    if (g == NULL || !g->journal.active)
+        return false;
+
+    g->journal.cellsSize = 0;
+    g->journal.membersSize = 0;
+    g->journal.active = false;
+    return true;
+}
+
 uint64_t gamma_busy_fields(gamma_t *g, uint32_t player) {
     if (wrongInput(g, player))
         return 0;
@@ -248,79 +791,104 @@ bool gamma_golden_possible(gamma_t *g, uint32_t player) {
     if (getAreas(g, player) < g->areas)
         return true;
 
-    uint32_t goldenUsed = getPlayer(g, player)->goldenMoves;
+    Member attacking = getPlayer(g, player);
+    if (!attacking->candidatesValid)
+        return goldenPossibleScan(g, player);
 
-    for (uint32_t x = 0; x < g->width; x++) {
-        for (uint32_t y = 0; y < g->height; y++) {
-            if (!isEmpty(g, x, y) && !isMine(g, player, x, y)
-                && numNeighbours(g, player, x, y) > 0) {
+    if (!isGoldenKnown(g, player)) {
+        g->lookups++;
+        attacking->watchedSize = 0;
+        attacking->goldenKnown = true;
+        attacking->goldenPossible = goldenPossibleCandidates(g, player);
+        attacking->checked = g->moves;
+    }
 
-                getPlayer(g, player)->goldenMoves = 0;
+    return attacking->goldenPossible;
+}
 
-                Member attackedPlayer = getPlayer(g, getOwner(g, x, y));
-                uint32_t previousOwner = attackedPlayer->id;
-                uint32_t previousOwnerGolden = attackedPlayer->goldenMoves;
-                attackedPlayer->goldenMoves = 0;
+char *gamma_board(gamma_t *g) {
+    if (g == NULL)
+        return NULL;
 
-                if (gamma_golden_move(g, player, x, y)) {
-                    gamma_golden_move(g, previousOwner, x, y);
-                    getPlayer(g, player)->goldenMoves = goldenUsed;
-                    attackedPlayer->goldenMoves = previousOwnerGolden;
+    uint64_t length = gamma_board_length(g) + 1;
+    if (length > SIZE_MAX)
+        return NULL;
 
-                    return true;
-                }
-                else {
-                    attackedPlayer->goldenMoves = previousOwnerGolden;
-                }
-            }
-        }
-    }
+    char *output = (char *) malloc(length);
+    if (output == NULL)
+        return NULL;
 
-    return false;
+    gamma_board_into(g, output, length);
+    return output;
 }
 
-char *gamma_board(gamma_t *g) {
+uint64_t gamma_board_length(gamma_t *g) {
     if (g == NULL)
-        return NULL;
+        return 0;
+
+    return (uint64_t) g->height *
+           ((uint64_t) g->width * g->fieldLength + 1);
+}
 
-    uint32_t numberLength = gamma_field_length(g);
+bool gamma_board_into(gamma_t *g, char *buf, uint64_t len) {
+    if (g == NULL || buf == NULL || len <= gamma_board_length(g))
+        return false;
 
-    uint64_t maxLength =
-            sizeof(char) *
-            ((uint64_t) g->height * ((uint64_t) g->width * numberLength + 1) + 1);
-    char *output = (char *) malloc(maxLength);
+    for (uint32_t y = g->height; y-- > 0;) { // prevent uint32_t flip
+        for (uint32_t x = 0; x < g->width;) {
+            uint64_t count;
+            const Node *run = nodesFrom(&g->board, getCell(g, x, y), &count);
+            if (count > g->width - x)
+                count = g->width - x;
+
+            for (uint64_t i = 0; i < count; i++)
+                buf = writeField(g, buf, run == NULL ? 0 : run[i].owner);
+            x += count;
+        }
 
-    if (output == NULL) {
-        return NULL;
+        *buf++ = '\n';
     }
 
-    size_t length = 0;
-    char integerString[32] = "";
+    *buf = '\0';
+    return true;
+}
+
+bool gamma_board_write(gamma_t *g, FILE *file) {
+    if (g == NULL || file == NULL)
+        return false;
+
+    char buf[WRITE_BUFFER_SIZE];
+    char *end = buf + WRITE_BUFFER_SIZE;
+    char *out = buf;
+
+    const Node *run = NULL;
+    uint64_t count = 0;
 
     for (uint32_t y = g->height; y-- > 0;) { // prevent uint32_t flip
-        for (uint32_t x = 0; x < g->width; x++) {
-            if (isEmpty(g, x, y)) {
-                for (uint32_t i = 0; i < numberLength - 1; i++)
-                    output[length++] = ' ';
+        for (uint32_t x = 0; x <= g->width; x++) {
+            // keep space for longest field or new line
+            if ((uint64_t) (end - out) < g->fieldLength) {
+                if (fwrite(buf, 1, out - buf, file) != (size_t) (out - buf))
+                    return false;
+                out = buf;
+            }
 
-                output[length++] = '.';
+            if (x == g->width) {
+                *out++ = '\n';
+                count = 0;
+                continue;
             }
-            else {
-                sprintf(integerString, "%"PRIu32"", getOwner(g, x, y));
-                uint32_t len = strlen(integerString);
 
-                for (uint32_t i = 0; i < numberLength - len; i++)
-                    output[length++] = ' ';
+            if (count == 0)
+                run = nodesFrom(&g->board, getCell(g, x, y), &count);
 
-                memcpy(output + length, integerString, len);
-                length += len;
-            }
+            out = writeField(g, out, run == NULL ? 0 : run->owner);
+            run = run == NULL ? NULL : run + 1;
+            count--;
         }
-        output[length++] = '\n';
     }
 
-    output[maxLength - 1] = '\0';
-    return output;
+    return fwrite(buf, 1, out - buf, file) == (size_t) (out - buf);
 }
 
 uint32_t gamma_next_player_id(gamma_t *g, uint32_t last) {
@@ -349,30 +917,24 @@ void gamma_print_player_info(gamma_t *g, uint32_t id) {
 }
 
 char *gamma_update_field(gamma_t *g, uint32_t x, uint32_t y) {
-    uint32_t length = 0;
-    char integerString[32] = "";
-
-    uint32_t fl = gamma_field_length(g);
-    char *output = malloc(fl + 1);
-
-    if (isEmpty(g, x, y)) {
-        for (uint32_t i = 0; i < fl - 1; i++)
-            output[length++] = ' ';
+    if (g == NULL)
+        return NULL;
 
-        output[length] = '.';
+    char *output = malloc(g->fieldLength + 1);
+    if (output != NULL && !gamma_field_into(g, x, y, output)) {
+        free(output);
+        return NULL;
     }
-    else {
-        sprintf(integerString, "%"PRIu32"", getOwner(g, x, y));
-        uint32_t len = strlen(integerString);
 
-        for (uint32_t i = 0; i < fl - len; i++)
-            output[length++] = ' ';
+    return output;
+}
 
-        memcpy(output + length, integerString, len);
-    }
+bool gamma_field_into(gamma_t *g, uint32_t x, uint32_t y, char *buf) {
+    if (g == NULL || buf == NULL || wrongCoordinates(g, x, y))
+        return false;
 
-    output[fl] = '\0';
-    return output;
+    *writeField(g, buf, getOwner(g, x, y)) = '\0';
+    return true;
 }
 
 inline uint32_t gamma_get_width(gamma_t *g) {
@@ -391,13 +953,5 @@ void gamma_all_players_summary(gamma_t *g) {
 }
 
 uint32_t gamma_field_length(gamma_t *g) {
-    char helper[32] = "";
-    sprintf(helper, "%"PRIu32"", g->players);
-    uint32_t numberLength = strlen(helper);
-
-    // one extra free space
-    if (numberLength > 1)
-        numberLength++;
-
-    return numberLength;
+    return g->fieldLength;
 }
@@ -11,6 +11,8 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
 
 /**
  * Struktura przechowująca stan gry.
@@ -31,6 +33,23 @@ typedef struct gamma gamma_t;
 gamma_t *gamma_new(uint32_t width, uint32_t height,
                    uint32_t players, uint32_t areas);
 
+/** @brief Creates game with sparse board.
+ * Works like gamma_new(), but memory of board grows with number of taken
+ * fields instead of its size, so huge boards with few moves are cheap.
+ * gamma_new() makes sparse board by itself if board together with its
+ * border has more than 2^36 fields, or more than 2^32 - 1 fields and
+ * memory for dense board can't be mapped. Games with sparse board can't
+ * be saved.
+ * @param width - game width
+ * @param height - game height
+ * @param players - number of players
+ * @param areas - maximal number of areas
+ * @return new game or NULL if parameters are wrong or there was not
+ * enough memory
+ */
+gamma_t *gamma_new_sparse(uint32_t width, uint32_t height,
+                          uint32_t players, uint32_t areas);
+
 /** @brief Usuwa strukturę przechowującą stan gry.
  * Usuwa z pamięci strukturę wskazywaną przez @p g.
  * Nic nie robi, jeśli wskaźnik ten ma wartość NULL.
@@ -38,6 +57,106 @@ gamma_t *gamma_new(uint32_t width, uint32_t height,
  */
 void gamma_delete(gamma_t *g);
 
+/** @brief Copies game.
+ * Makes independent game with the same board, players and state of golden
+ * moves as @p g. Transaction of @p g is not copied. Doesn't change @p g,
+ * so it can be called by many threads at once while no move is made.
+ * Copy of game with board in file keeps board in memory, which has to
+ * fit pages with taken fields.
+ * @param g - copied game
+ * @return copy of @p g or NULL if @p g is NULL or there was not enough memory
+ */
+gamma_t *gamma_clone(gamma_t *g);
+
+/** @brief Creates game with given owners of fields.
+ * Computes areas and players' counters from board at once, without
+ * making moves, using many threads for big boards. Players haven't used
+ * their golden moves.
+ * @param width - game width
+ * @param height - game height
+ * @param players - number of players
+ * @param areas - maximal number of areas
+ * @param owners - @p width * @p height owners of fields row after row,
+ * from y = 0, 0 for empty field
+ * @return new game or NULL if parameters are wrong, some player has
+ * more than @p areas areas or there was not enough memory
+ */
+gamma_t *gamma_import(uint32_t width, uint32_t height, uint32_t players,
+                      uint32_t areas, const uint32_t *owners);
+
+/** @brief Creates game from board written by gamma_board().
+ * Reads whole board in one pass and computes areas at once, like
+ * gamma_import(). Size of board is taken from @p text.
+ * @param text - board written by gamma_board() of game with @p players
+ * players
+ * @param players - number of players
+ * @param areas - maximal number of areas
+ * @param goldenUsed - array of numbers of golden moves used by every
+ * player or NULL if none was used
+ * @return new game or NULL if @p text is not correct board, some player
+ * has more than @p areas areas or there was not enough memory
+ */
+gamma_t *gamma_from_board_text(const char *text, uint32_t players,
+                               uint32_t areas, const uint32_t *goldenUsed);
+
+/** @brief Saves game to file.
+ * Writes board with its areas and players' counters in binary format,
+ * so game can be read by gamma_load() without making moves again.
+ * @param g - current game
+ * @param file - file opened for writing in binary mode
+ * @return true if game was saved else false
+ */
+bool gamma_save(gamma_t *g, FILE *file);
+
+/** @brief Loads game saved by gamma_save().
+ * Reads game from current position of @p file and checks that it is
+ * correct.
+ * @param file - file opened for reading in binary mode
+ * @return loaded game or NULL if file doesn't contain correct game or
+ * there was not enough memory
+ */
+gamma_t *gamma_load(FILE *file);
+
+/** @brief Creates game whose board is kept in file.
+ * Board is mapped from file @p path in square tiles, so it doesn't have
+ * to fit in memory and nearby fields are on the same pages. File is made
+ * again if it exists. Game is used like any other, but it can't be saved
+ * by gamma_save(). gamma_delete() rolls back started transaction and
+ * writes the game to the disk.
+ * @param width - game width
+ * @param height - game height
+ * @param players - number of players
+ * @param areas - maximal number of areas
+ * @param path - path of file
+ * @return new game or NULL if parameters are wrong, file couldn't be made
+ * or there was not enough memory
+ */
+gamma_t *gamma_new_mapped(uint32_t width, uint32_t height,
+                          uint32_t players, uint32_t areas,
+                          const char *path);
+
+/** @brief Opens game whose board is kept in file.
+ * Maps board from file of game and checks that it is correct game.
+ * Moves made after the last gamma_sync() are kept even if process ended
+ * without gamma_delete(), as board and used golden moves are shared with
+ * the file and other counters are counted again. File that is rejected
+ * isn't changed.
+ * @param path - path of file of game made by gamma_new_mapped()
+ * @return opened game or NULL if file doesn't contain correct game or
+ * there was not enough memory
+ */
+gamma_t *gamma_open_mapped(const char *path);
+
+/** @brief Writes game whose board is kept in file to the disk.
+ * Board is written to file by the system at any time, and only this
+ * function waits until it is written. File may be torn if the system
+ * stops before that, process that ends doesn't tear it.
+ * @param g - game made by gamma_new_mapped() or gamma_open_mapped()
+ * @return true if game was written else false, also if @p g has other
+ * board or transaction was started
+ */
+bool gamma_sync(gamma_t *g);
+
 /** @brief Wykonuje ruch.
  * Ustawia pionek gracza @p player na polu (@p x, @p y).
  * @param[in,out] g   – wskaźnik na strukturę przechowującą stan gry,
@@ -52,6 +171,27 @@ void gamma_delete(gamma_t *g);
  */
 bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
 
+/** @brief Move of player on field.
+ * Arguments of gamma_move() and gamma_golden_move().
+ */
+typedef struct move {
+    uint32_t player;            /**< Id of moving player */
+    uint32_t x;                 /**< First coordinate */
+    uint32_t y;                 /**< Second coordinate */
+} move_t;
+
+/** @brief Makes many moves.
+ * Makes moves one after another, with the same results as gamma_move()
+ * called for each of them.
+ * @param g - current game
+ * @param moves - array of @p n moves
+ * @param n - number of moves
+ * @param results - array for @p n results of moves or NULL
+ * @return number of moves that were made
+ */
+size_t gamma_move_batch(gamma_t *g, const move_t *moves, size_t n,
+                        bool *results);
+
 /** @brief Wykonuje złoty ruch.
  * Ustawia pionek gracza @p player na polu (@p x, @p y) zajętym przez innego
  * gracza, usuwając pionek innego gracza.
@@ -68,6 +208,54 @@ bool gamma_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
  */
 bool gamma_golden_move(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
 
+/** @brief Makes many golden moves.
+ * Makes golden moves one after another, with the same results as
+ * gamma_golden_move() called for each of them.
+ * @param g - current game
+ * @param moves - array of @p n moves
+ * @param n - number of moves
+ * @param results - array for @p n results of moves or NULL
+ * @return number of golden moves that were made
+ */
+size_t gamma_golden_move_batch(gamma_t *g, const move_t *moves, size_t n,
+                               bool *results);
+
+/** @brief Checks if golden move can be done.
+ * Checks if gamma_golden_move() with the same parameters would succeed
+ * without changing the game, so it can be called by many threads
+ * at once while no move is made.
+ * @param g - current game
+ * @param player - id of attacking player
+ * @param x - first coordinate
+ * @param y - second coordinate
+ * @return true if golden move can be done else false
+ */
+bool gamma_golden_move_legal(gamma_t *g, uint32_t player,
+                             uint32_t x, uint32_t y);
+
+/** @brief Begins transaction.
+ * Every change made to the game since now is remembered, so it can be
+ * undone by gamma_rollback() in time proportional to number of changes.
+ * Transactions can't be nested.
+ * @param g - current game
+ * @return true if transaction began else false
+ */
+bool gamma_begin(gamma_t *g);
+
+/** @brief Undoes transaction.
+ * Brings back the game from the moment when gamma_begin() was called
+ * and ends transaction.
+ * @param g - current game
+ * @return true if there was transaction to undo else false
+ */
+bool gamma_rollback(gamma_t *g);
+
+/** @brief Ends transaction keeping its changes.
+ * @param g - current game
+ * @return true if there was transaction to end else false
+ */
+bool gamma_commit(gamma_t *g);
+
 /** @brief Podaje liczbę pól zajętych przez gracza.
  * Podaje liczbę pól zajętych przez gracza @p player.
  * @param[in] g       – wskaźnik na strukturę przechowującą stan gry,
@@ -111,6 +299,31 @@ bool gamma_golden_possible(gamma_t *g, uint32_t player);
  */
 char *gamma_board(gamma_t *g);
 
+/** @brief Gives length of board description.
+ * @param g - current game
+ * @return number of chars written by gamma_board_into() without '\0'
+ * or 0 if @p g is NULL
+ */
+uint64_t gamma_board_length(gamma_t *g);
+
+/** @brief Writes board description into given buffer.
+ * Writes the same description as gamma_board() without allocating memory.
+ * @param g - current game
+ * @param buf - buffer for description
+ * @param len - size of @p buf, at least gamma_board_length() + 1
+ * @return true if description was written else false
+ */
+bool gamma_board_into(gamma_t *g, char *buf, uint64_t len);
+
+/** @brief Writes board description to file.
+ * Writes the same description as gamma_board() through buffer of fixed size,
+ * so memory used doesn't depend on board size.
+ * @param g - current game
+ * @param file - open file
+ * @return true if whole description was written else false
+ */
+bool gamma_board_write(gamma_t *g, FILE *file);
+
 /** @brief Id of next player in current game.
  * Id of player after @p last in game @p g who can make move
  * @param g - current game
@@ -135,6 +348,16 @@ void gamma_print_player_info(gamma_t *g, uint32_t id);
  */
 char *gamma_update_field(gamma_t *g, uint32_t x, uint32_t y);
 
+/** @brief Writes string of field into given buffer.
+ * Writes the same string as gamma_update_field() without allocating memory.
+ * @param g - current game
+ * @param x - first coordinate
+ * @param y - second coordinate
+ * @param buf - buffer of size at least gamma_field_length() + 1
+ * @return true if field was written else false
+ */
+bool gamma_field_into(gamma_t *g, uint32_t x, uint32_t y, char *buf);
+
 /** @brief Return game width.
  * return gamma game @p g width
  * @param g - current game
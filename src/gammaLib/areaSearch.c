@@ -0,0 +1,326 @@
+/** @file
+ * Implementation of searches of areas split by removing a field.
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+#include "areaSearch.h"
+#include "gammaEngineLib.h"
+#include <string.h>
+
+/**
+ * Multiplier of Fibonacci hashing.
+ */
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15u
+
+/**
+ * Initial number of slots in hash map of visited fields.
+ */
+#define INITIAL_MAP_SIZE 64
+
+/**
+ * Label of area that doesn't exist.
+ */
+#define NO_AREA SEARCHES
+
+/** @brief Gives slot of field in hash map.
+ * @param s - search memory
+ * @param elem - index of field
+ * @return slot with @p elem or empty slot where it should be
+ */
+static visit *findSlot(Search *s, cell_t elem);
+
+/** @brief Grows hash map of visited fields.
+ * Doubles number of slots and inserts visited fields again.
+ * @param s - search memory
+ * @return false if there was not enough memory else true
+ */
+static bool growMap(Search *s);
+
+/** @brief Grows arrays of visited fields.
+ * @param s - search memory
+ * @return false if there was not enough memory else true
+ */
+static bool growVisited(Search *s);
+
+/** @brief Marks field as visited.
+ * Appends field to queue of search @p label.
+ * @param g - current game
+ * @param s - search memory
+ * @param elem - index of field
+ * @param label - search that visited field
+ * @param head - first field in queue of search @p label
+ * @param tail - last field in queue of search @p label
+ * @return false if there was not enough memory else true
+ */
+static bool visitField(gamma_t *g, Search *s, cell_t elem, uint8_t label,
+                       cell_t *head, cell_t *tail);
+
+/** @brief Gives area found by search.
+ * @param s - search memory
+ * @param label - search
+ * @return search representing the same area
+ */
+static uint8_t groupOf(Search *s, uint8_t label);
+
+/** @brief Counts areas which still have fields to visit.
+ * @param s - search memory
+ * @return number of areas not fully visited
+ */
+static uint32_t openAreas(Search *s);
+
+// ----------------------------------------------------------------------------
+
+void initSearch(Search *s) {
+    *s = (Search) {NULL, NULL, NULL, 0, 0, NULL, 0, 0,
+                   0, {0}, {false}, {false}, {0}, 0};
+}
+
+void freeSearch(Search *s) {
+    free(s->visited);
+    free(s->next);
+    free(s->label);
+    free(s->map);
+    initSearch(s);
+}
+
+static visit *findSlot(Search *s, cell_t elem) {
+    uint64_t mask = s->mapSize - 1;
+    uint64_t slot = (((uint64_t) elem * HASH_MULTIPLIER) >> 32u) & mask;
+
+    while (s->map[slot].stamp == s->stamp && s->map[slot].elem != elem)
+        slot = (slot + 1) & mask;
+
+    return &s->map[slot];
+}
+
+static bool growMap(Search *s) {
+    uint64_t mapSize = s->mapSize == 0 ? INITIAL_MAP_SIZE : 2 * s->mapSize;
+    if (mapSize > SIZE_MAX / sizeof(visit))
+        return false;
+
+    visit *map = calloc(mapSize, sizeof(visit));
+    if (map == NULL)
+        return false;
+
+    free(s->map);
+    s->map = map;
+    s->mapSize = mapSize;
+    s->stamp = 1;
+
+    for (uint64_t i = 0; i < s->size; i++)
+        *findSlot(s, s->visited[i]) = (visit) {s->visited[i], i, s->stamp};
+
+    return true;
+}
+
+static bool growVisited(Search *s) {
+    uint64_t capacity = s->capacity == 0 ? INITIAL_MAP_SIZE : 2 * s->capacity;
+    if (capacity > SIZE_MAX / sizeof(cell_t))
+        return false;
+
+    cell_t *visited = realloc(s->visited, capacity * sizeof(cell_t));
+    if (visited == NULL)
+        return false;
+    s->visited = visited;
+
+    cell_t *next = realloc(s->next, capacity * sizeof(cell_t));
+    if (next == NULL)
+        return false;
+    s->next = next;
+
+    uint8_t *label = realloc(s->label, capacity * sizeof(uint8_t));
+    if (label == NULL)
+        return false;
+    s->label = label;
+
+    s->capacity = capacity;
+    return true;
+}
+
+static bool visitField(gamma_t *g, Search *s, cell_t elem, uint8_t label,
+                       cell_t *head, cell_t *tail) {
+    if (s->size == s->capacity && !growVisited(s))
+        return false;
+
+    // keep hash map at most half full
+    if (2 * (s->size + 1) > s->mapSize && !growMap(s))
+        return false;
+
+    cell_t order = s->size++;
+    *findSlot(s, elem) = (visit) {elem, order, s->stamp};
+    s->visited[order] = elem;
+    s->next[order] = NO_CELL;
+    s->label[order] = label;
+
+    if (*head == NO_CELL)
+        *head = order;
+    else
+        s->next[*tail] = order;
+    *tail = order;
+
+    s->count[label]++;
+    if (nodeAt(&g->board, elem)->rank > 0)
+        s->internal[label] = true;
+
+    return true;
+}
+
+static uint8_t groupOf(Search *s, uint8_t label) {
+    while (s->group[label] != label)
+        label = s->group[label];
+
+    return label;
+}
+
+static uint32_t openAreas(Search *s) {
+    bool open[SEARCHES] = {false};
+    uint32_t output = 0;
+
+    for (uint8_t label = 0; label < s->searches; label++) {
+        uint8_t group = groupOf(s, label);
+        if (s->open[label] && !open[group]) {
+            open[group] = true;
+            output++;
+        }
+    }
+
+    return output;
+}
+
+bool searchSplit(gamma_t *g, Search *s, uint32_t player, cell_t removed) {
+    cell_t head[SEARCHES], tail[SEARCHES];
+    cell_t arr[4];
+
+    s->size = 0;
+    s->searches = 0;
+    s->areas = 0;
+
+    if (s->mapSize == 0 && !growMap(s))
+        return false;
+
+    // forget previous search, unless stamps were used up
+    if (++s->stamp == 0) {
+        memset(s->map, 0, s->mapSize * sizeof(visit));
+        s->stamp = 1;
+    }
+
+    nearbyCells(g, arr, removed);
+    for (int i = 0; i < 4; i++) {
+        if (nodeAt(&g->board, arr[i])->owner != player)
+            continue;
+
+        uint8_t label = s->searches++;
+        s->group[label] = label;
+        s->open[label] = true;
+        s->internal[label] = false;
+        s->count[label] = 0;
+        head[label] = NO_CELL;
+
+        if (!visitField(g, s, arr[i], label, &head[label], &tail[label]))
+            return false;
+    }
+
+    while (openAreas(s) > 1) {
+        for (uint8_t label = 0; label < s->searches; label++) {
+            if (!s->open[label])
+                continue;
+
+            cell_t elem = s->visited[head[label]];
+            head[label] = s->next[head[label]];
+
+            nearbyCells(g, arr, elem);
+            for (int i = 0; i < 4; i++) {
+                if (arr[i] == removed ||
+                    nodeAt(&g->board, arr[i])->owner != player)
+                    continue;
+
+                visit *slot = findSlot(s, arr[i]);
+                if (slot->stamp != s->stamp) {
+                    if (!visitField(g, s, arr[i], label,
+                                    &head[label], &tail[label]))
+                        return false;
+                }
+                else {
+                    // searches met, so they found the same area
+                    uint8_t a = groupOf(s, label);
+                    uint8_t b = groupOf(s, s->label[slot->order]);
+                    if (a < b)
+                        s->group[b] = a;
+                    else
+                        s->group[a] = b;
+                }
+            }
+
+            s->open[label] = head[label] != NO_CELL;
+        }
+    }
+
+    for (uint8_t label = 0; label < s->searches; label++)
+        s->areas += groupOf(s, label) == label;
+
+    return true;
+}
+
+bool relabelSplit(gamma_t *g, Search *s, cell_t removed) {
+    bool open[SEARCHES] = {false};
+    bool internal[SEARCHES] = {false};
+    uint64_t count[SEARCHES] = {0};
+    uint8_t kept = NO_AREA;
+
+    // removed field may be on path of other Nodes to root
+    if (nodeAt(&g->board, removed)->rank > 0)
+        return false;
+
+    for (uint8_t label = 0; label < s->searches; label++) {
+        uint8_t group = groupOf(s, label);
+        open[group] |= s->open[label];
+        internal[group] |= s->internal[label];
+        count[group] += s->count[label];
+    }
+
+    // area that wasn't fully visited keeps old root
+    for (uint8_t group = 0; group < s->searches; group++)
+        if (open[group])
+            kept = group;
+
+    // otherwise the one that has Nodes with sons or the biggest one
+    for (uint8_t group = 0; group < s->searches && kept == NO_AREA; group++)
+        if (internal[group])
+            kept = group;
+
+    bool biggest = kept == NO_AREA;
+    for (uint8_t group = 0; biggest && group < s->searches; group++)
+        if (groupOf(s, group) == group &&
+            (kept == NO_AREA || count[group] > count[kept]))
+            kept = group;
+
+    for (uint8_t group = 0; group < s->searches; group++)
+        if (group != kept && internal[group])
+            return false;
+
+    cell_t first[SEARCHES] = {NO_CELL, NO_CELL, NO_CELL, NO_CELL};
+
+    for (uint64_t i = 0; i < s->size; i++)
+        if (groupOf(s, s->label[i]) != kept)
+            journalCell(g, s->visited[i]);
+    journalCell(g, removed);
+
+    for (uint64_t i = 0; i < s->size; i++)
+        if (groupOf(s, s->label[i]) != kept)
+            clearNodeData(&g->board, s->visited[i]);
+
+    for (uint64_t i = 0; i < s->size; i++) {
+        uint8_t group = groupOf(s, s->label[i]);
+        if (group == kept)
+            continue;
+
+        if (first[group] == NO_CELL)
+            first[group] = s->visited[i];
+        else
+            merge(&g->board, first[group], s->visited[i]);
+    }
+
+    clearNodeData(&g->board, removed);
+    return true;
+}
@@ -0,0 +1,102 @@
+/** @file
+ * Interface of searches of areas split by removing a field.
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+#ifndef GAMMA_AREASEARCH_H
+#define GAMMA_AREASEARCH_H
+
+#include "../findUnionLib/findUnion.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Maximal number of searches, one for every nearby field.
+ */
+#define SEARCHES 4
+
+/**
+ * Game structure.
+ */
+typedef struct gamma gamma_t;
+
+/** @brief Slot of hash map of visited fields.
+ *
+ * Slot is used only if its stamp is equal to the stamp of current search.
+ */
+struct visit {
+    cell_t elem;                /**< Index of visited field */
+    cell_t order;               /**< Position of field in visited */
+    uint32_t stamp;             /**< Stamp of search that used slot */
+};
+
+/**
+ * Slot of hash map of visited fields.
+ */
+typedef struct visit visit;
+
+/** @brief Memory used by searches started around removed field.
+ *
+ * Searches are started from every field of player next to removed one
+ * and stop as soon as at most one of found areas is not fully visited.
+ * Memory is kept between searches, so it is allocated only when it grows.
+ */
+struct search {
+    cell_t *visited;            /**< Visited fields in order of visiting */
+    cell_t *next;               /**< Next field in queue of the same search */
+    uint8_t *label;             /**< Search that visited field */
+    uint64_t size;              /**< Number of visited fields */
+    uint64_t capacity;          /**< Capacity of visited, next and label */
+
+    visit *map;                 /**< Hash map of visited fields */
+    uint64_t mapSize;           /**< Number of slots in map, power of 2 */
+    uint32_t stamp;             /**< Stamp of current search */
+
+    uint32_t searches;          /**< Number of started searches */
+    uint8_t group[SEARCHES];    /**< Area found by every search */
+    bool open[SEARCHES];        /**< If search has fields left to visit */
+    bool internal[SEARCHES];    /**< If search visited Node with sons */
+    uint64_t count[SEARCHES];   /**< Number of fields visited by search */
+    uint32_t areas;             /**< Number of areas found */
+};
+
+/**
+ * Memory used by searches started around removed field.
+ */
+typedef struct search Search;
+
+/** @brief Initializes empty search memory.
+ * @param s - search memory
+ */
+void initSearch(Search *s);
+
+/** @brief Frees search memory.
+ * @param s - search memory
+ */
+void freeSearch(Search *s);
+
+/** @brief Counts areas made by removing field.
+ * Runs interleaved searches from fields of @p player next to @p removed,
+ * as if @p removed was empty, until at most one of found areas
+ * is not fully visited. Doesn't change the board.
+ * @param g - current game
+ * @param s - search memory
+ * @param player - Member's id, owner of @p removed
+ * @param removed - index of removed field
+ * @return false if there was not enough memory else true
+ */
+bool searchSplit(gamma_t *g, Search *s, uint32_t player, cell_t removed);
+
+/** @brief Removes field from its area after searchSplit().
+ * Makes every fully visited area, except the one that keeps old root,
+ * a separate set and detaches @p removed from its set. Does nothing if
+ * Nodes outside those areas may still lead through them to the root.
+ * @param g - current game
+ * @param s - search memory filled by searchSplit()
+ * @param removed - index of removed field
+ * @return true if areas were relabelled else false
+ */
+bool relabelSplit(gamma_t *g, Search *s, cell_t removed);
+
+#endif //GAMMA_AREASEARCH_H
@@ -0,0 +1,288 @@
+/** @file
+ * Implementation of building game from grid of owners.
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+/** Enables POSIX functions used to count processors */
+#define _XOPEN_SOURCE 700
+
+#include "boardImport.h"
+#include "gammaEngineLib.h"
+#include <pthread.h>
+#include <unistd.h>
+#include <string.h>
+
+/** @brief Rows of board labelled by one thread.
+ */
+struct strip {
+    gamma_t *g;                 /**< Filled game */
+    const uint32_t *owners;     /**< Owners of fields row after row */
+    uint32_t begin;             /**< First row of strip */
+    uint32_t end;               /**< Row after the last one of strip */
+    bool correct;               /**< If every owner in strip is a player */
+};
+
+/**
+ * Rows of board labelled by one thread.
+ */
+typedef struct strip strip;
+
+/** @brief Joins areas of two fields.
+ * @param board - board
+ * @param a - index of first field
+ * @param b - index of second field
+ */
+static void join(Board *board, cell_t a, cell_t b);
+
+/** @brief Fills rows of strip and joins their nearby fields.
+ * Areas of strip are joined only inside of it.
+ * @param arg - strip
+ * @return NULL
+ */
+static void *labelStrip(void *arg);
+
+/** @brief Gives number of threads used for board.
+ * @param g - filled game
+ * @return number of strips of board
+ */
+static uint32_t stripsOf(gamma_t *g);
+
+/** @brief Counts players' fields, areas and surrounding fields.
+ * @param g - game with labelled board
+ * @return false if some player has too many areas else true
+ */
+static bool countMembers(gamma_t *g);
+
+/** @brief Reads one field of written board.
+ * @param field - beginning of field
+ * @param fieldLength - length of field
+ * @param owner - memory for owner of field
+ * @return true if field was read else false
+ */
+static bool parseField(const char *field, uint32_t fieldLength,
+                       uint32_t *owner);
+
+// ----------------------------------------------------------------------------
+
+static void join(Board *board, cell_t a, cell_t b) {
+    merge(board, find(board, a), find(board, b));
+}
+
+static void *labelStrip(void *arg) {
+    strip *s = arg;
+    gamma_t *g = s->g;
+    Node *nodes = g->board.nodes;
+    uint64_t stride = g->board.stride;
+
+    for (uint32_t y = s->begin; y < s->end; y++) {
+        for (uint32_t x = 0; x < g->width; x++) {
+            cell_t elem = getCell(g, x, y);
+            uint32_t owner = s->owners[(uint64_t) y * g->width + x];
+
+            if (owner > g->players) {
+                s->correct = false;
+                owner = 0;
+            }
+
+            initRoot(&g->board, elem, owner);
+            if (owner == 0)
+                continue;
+
+            // border never has the owner of a field
+            if (nodes[elem - 1].owner == owner)
+                join(&g->board, elem - 1, elem);
+            if (y > s->begin && nodes[elem - stride].owner == owner)
+                join(&g->board, elem - stride, elem);
+        }
+    }
+
+    return NULL;
+}
+
+static uint32_t stripsOf(gamma_t *g) {
+    uint64_t size = (uint64_t) g->width * (uint64_t) g->height;
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+    uint64_t strips = size / IMPORT_STRIP_FIELDS;
+    if (processors > 0 && strips > (uint64_t) processors)
+        strips = (uint64_t) processors;
+    if (strips > IMPORT_THREADS)
+        strips = IMPORT_THREADS;
+    if (strips > g->height)
+        strips = g->height;
+
+    return strips == 0 ? 1 : (uint32_t) strips;
+}
+
+static bool countMembers(gamma_t *g) {
+    Node *nodes = g->board.nodes;
+    g->available = 0;
+
+    for (cell_t elem = 0; elem < g->board.size; elem++) {
+        if (isBorder(&g->board, elem))
+            continue;
+
+        uint32_t owner = nodes[elem].owner;
+
+
+        if (owner != 0) {
+            Member m = getPlayer(g, owner);
+            m->owned++;
+            m->areas += parentOf(&nodes[elem], elem) == elem;
+            continue;
+        }
+
+        g->available++;
+
+        // every player is counted once for each empty field
+        cell_t arr[4];
+        nearbyCells(g, arr, elem);
+        for (int i = 0; i < 4; i++) {
+            if (!isTakenCell(g, arr[i]))
+                continue;
+
+            uint32_t nearby = nodes[arr[i]].owner;
+            bool counted = false;
+            for (int j = 0; j < i; j++)
+                if (nodes[arr[j]].owner == nearby)
+                    counted = true;
+
+            if (!counted)
+                getPlayer(g, nearby)->surrounding++;
+        }
+    }
+
+    for (uint32_t i = 0; i < g->players; i++)
+        if (getPlayer(g, i + 1)->areas > g->areas)
+            return false;
+
+    return true;
+}
+
+bool importBoard(gamma_t *g, const uint32_t *owners) {
+    Node *nodes = g->board.nodes;
+    if (nodes == NULL)
+        return false;
+
+    // every page is written by labelling anyway
+    writeBorder(&g->board);
+
+    uint32_t strips = stripsOf(g);
+    strip parts[IMPORT_THREADS];
+    pthread_t threads[IMPORT_THREADS];
+    bool started[IMPORT_THREADS];
+
+    for (uint32_t i = 0; i < strips; i++) {
+        uint32_t begin = (uint64_t) g->height * i / strips;
+        uint32_t end = (uint64_t) g->height * (i + 1) / strips;
+        parts[i] = (strip) {g, owners, begin, end, true};
+
+        // the first strip is labelled by this thread meanwhile
+        started[i] = i > 0 &&
+                     pthread_create(&threads[i], NULL, labelStrip,
+                                    &parts[i]) == 0;
+    }
+
+    labelStrip(&parts[0]);
+
+    bool correct = parts[0].correct;
+    for (uint32_t i = 1; i < strips; i++) {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+        else
+            labelStrip(&parts[i]);
+
+        correct &= parts[i].correct;
+    }
+
+    if (!correct)
+        return false;
+
+    // areas crossing borders of strips
+    for (uint32_t i = 1; i < strips; i++) {
+        for (uint32_t x = 0; x < g->width; x++) {
+            cell_t elem = getCell(g, x, parts[i].begin);
+            uint32_t owner = nodes[elem].owner;
+
+            if (owner != 0 && nodes[elem - g->board.stride].owner == owner)
+                join(&g->board, elem - g->board.stride, elem);
+        }
+    }
+
+    if (!countMembers(g))
+        return false;
+
+    addAllCandidates(g);
+    return true;
+}
+
+bool boardTextSize(const char *text, uint32_t fieldLength,
+                   uint32_t *width, uint32_t *height) {
+    const char *newLine = strchr(text, '\n');
+    if (newLine == NULL || newLine == text)
+        return false;
+
+    uint64_t lineLength = newLine - text;
+    uint64_t length = strlen(text);
+
+    if (lineLength % fieldLength != 0 || length % (lineLength + 1) != 0 ||
+        lineLength / fieldLength > UINT32_MAX ||
+        length / (lineLength + 1) > UINT32_MAX)
+        return false;
+
+    *width = lineLength / fieldLength;
+    *height = length / (lineLength + 1);
+    return true;
+}
+
+static bool parseField(const char *field, uint32_t fieldLength,
+                       uint32_t *owner) {
+    const char *end = field + fieldLength;
+    while (field < end && *field == ' ')
+        field++;
+
+    if (field == end)
+        return false;
+
+    if (*field == '.') {
+        *owner = 0;
+        return field + 1 == end;
+    }
+
+    // ids are written without leading zeros
+    if (*field == '0')
+        return false;
+
+    uint64_t value = 0;
+    for (; field < end; field++) {
+        if (*field < '0' || *field > '9')
+            return false;
+
+        value = 10 * value + (uint64_t) (*field - '0');
+        if (value > UINT32_MAX)
+            return false;
+    }
+
+    *owner = value;
+    return true;
+}
+
+bool parseBoardText(const char *text, uint32_t fieldLength,
+                    uint32_t width, uint32_t height, uint32_t *owners) {
+    // the first written row is the top one
+    for (uint32_t y = height; y-- > 0;) {
+        uint32_t *row = owners + (uint64_t) y * width;
+
+        for (uint32_t x = 0; x < width; x++) {
+            if (!parseField(text, fieldLength, &row[x]))
+                return false;
+            text += fieldLength;
+        }
+
+        if (*text++ != '\n')
+            return false;
+    }
+
+    return true;
+}
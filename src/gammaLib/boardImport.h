@@ -0,0 +1,64 @@
+/** @file
+ * Interface of building game from grid of owners.
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+#ifndef GAMMA_BOARDIMPORT_H
+#define GAMMA_BOARDIMPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Maximal number of threads labelling areas.
+ */
+#define IMPORT_THREADS 64
+
+/**
+ * Minimal number of fields labelled by one thread.
+ */
+#define IMPORT_STRIP_FIELDS (1u << 20u)
+
+/**
+ * Game structure.
+ */
+typedef struct gamma gamma_t;
+
+/** @brief Fills new game with given owners of fields.
+ * Board is cut into strips of rows whose areas are found by separate
+ * threads, then areas crossing borders of strips are merged. After that
+ * players' counters and golden move candidates are computed.
+ * @param g - new game without any moves, with dense board
+ * @param owners - owners of fields row after row, 0 for empty field
+ * @return false if board is sparse, some owner is not a player or some
+ * player has too many areas else true
+ */
+bool importBoard(gamma_t *g, const uint32_t *owners);
+
+/** @brief Gives size of board written by gamma_board().
+ * Every line has to have the same number of fields of length
+ * @p fieldLength and has to end with '\n'.
+ * @param text - written board
+ * @param fieldLength - length of every field
+ * @param width - memory for game width
+ * @param height - memory for game height
+ * @return true if board has correct size else false
+ */
+bool boardTextSize(const char *text, uint32_t fieldLength,
+                   uint32_t *width, uint32_t *height);
+
+/** @brief Reads owners of fields from board written by gamma_board().
+ * Fields are ids aligned to the right with spaces or '.' for empty field,
+ * rows are written from the top one.
+ * @param text - written board of size given by boardTextSize()
+ * @param fieldLength - length of every field
+ * @param width - game width
+ * @param height - game height
+ * @param owners - memory for owners of fields row after row, from y = 0
+ * @return true if every field was read else false
+ */
+bool parseBoardText(const char *text, uint32_t fieldLength,
+                    uint32_t width, uint32_t height, uint32_t *owners);
+
+#endif //GAMMA_BOARDIMPORT_H
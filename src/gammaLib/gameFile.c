@@ -0,0 +1,358 @@
+/** @file
+ * Implementation of binary files with saved games.
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+#include "gameFile.h"
+#include "gammaEngineLib.h"
+#include <string.h>
+
+/** @brief Makes header of file with game.
+ * @param g - current game
+ * @param layout - layout of board in file
+ * @return header describing @p g
+ */
+static fileHeader headerOf(gamma_t *g, uint32_t layout);
+
+/** @brief Makes counters of player written in file.
+ * @param g - current game
+ * @param player - player's id
+ * @return counters of @p player
+ */
+static fileMember memberOf(gamma_t *g, uint32_t player);
+
+/** @brief Gives counters of player in mapped head of file board.
+ * @param g - current game with file board
+ * @param player - player's id
+ * @return counters of @p player in file
+ */
+static fileMember *mappedMember(gamma_t *g, uint32_t player);
+
+/** @brief Writes zeros to file.
+ * @param file - file opened for writing
+ * @param count - number of zeros
+ * @return true if all zeros were written else false
+ */
+static bool writeZeros(FILE *file, uint64_t count);
+
+/** @brief Reads and ignores bytes of file.
+ * @param file - file opened for reading
+ * @param count - number of bytes
+ * @return true if all bytes were read else false
+ */
+static bool skipBytes(FILE *file, uint64_t count);
+
+/** @brief Reads players' counters.
+ * @param g - new game
+ * @param file - file opened for reading
+ * @return true if counters were read and are correct else false
+ */
+static bool readMembers(gamma_t *g, FILE *file);
+
+/** @brief Checks read board.
+ * Checks that every Node leads to root owned by the same player, that
+ * nearby fields of the same player have the same root and that counters
+ * of players agree with the board.
+ * @param g - new game with read board and players
+ * @return true if board is correct else false
+ */
+static bool checkBoard(gamma_t *g);
+
+/** @brief Counts players' counters and empty fields from the board.
+ * @param g - new game with read board
+ * @return true if owners and areas of players are correct else false
+ */
+static bool countGame(gamma_t *g);
+
+/** @brief Checks game with read board and counters and prepares it.
+ * @param g - new game with read board and players
+ * @return true if game is correct else false
+ */
+static bool checkGame(gamma_t *g);
+
+// ----------------------------------------------------------------------------
+
+uint64_t boardOffsetOf(uint32_t players) {
+    uint64_t offset = sizeof(fileHeader) +
+                      (uint64_t) players * sizeof(fileMember);
+    return (offset + FILE_ALIGNMENT - 1) / FILE_ALIGNMENT * FILE_ALIGNMENT;
+}
+
+static fileMember *mappedMember(gamma_t *g, uint32_t player) {
+    return (fileMember *) (g->board.head + sizeof(fileHeader)) + player - 1;
+}
+
+static bool writeZeros(FILE *file, uint64_t count) {
+    static const char zeros[FILE_ALIGNMENT] = {0};
+
+    while (count > 0) {
+        size_t part = count < FILE_ALIGNMENT ? count : FILE_ALIGNMENT;
+        if (fwrite(zeros, 1, part, file) != part)
+            return false;
+        count -= part;
+    }
+
+    return true;
+}
+
+static bool skipBytes(FILE *file, uint64_t count) {
+    char buffer[FILE_ALIGNMENT];
+
+    while (count > 0) {
+        size_t part = count < FILE_ALIGNMENT ? count : FILE_ALIGNMENT;
+        if (fread(buffer, 1, part, file) != part)
+            return false;
+        count -= part;
+    }
+
+    return true;
+}
+
+static fileHeader headerOf(gamma_t *g, uint32_t layout) {
+    return (fileHeader) {FILE_MAGIC, FILE_VERSION, FILE_BYTE_ORDER,
+                         sizeof(Node), sizeof(fileMember),
+                         g->width, g->height, g->players, g->areas,
+                         g->numGoldenMoves, layout, g->available,
+                         boardOffsetOf(g->players)};
+}
+
+static fileMember memberOf(gamma_t *g, uint32_t player) {
+    Member m = getPlayer(g, player);
+    return (fileMember) {m->id, m->areas, m->owned, m->surrounding,
+                         m->goldenMoves, 0};
+}
+
+bool writeGame(gamma_t *g, FILE *file) {
+    // sparse board is too big to be written field after field
+    if (g->board.nodes == NULL)
+        return false;
+
+    fileHeader header = headerOf(g, FILE_LAYOUT_ROWS);
+    if (fwrite(&header, sizeof(fileHeader), 1, file) != 1)
+        return false;
+
+    for (uint32_t i = 0; i < g->players; i++) {
+        fileMember saved = memberOf(g, i + 1);
+        if (fwrite(&saved, sizeof(fileMember), 1, file) != 1)
+            return false;
+    }
+
+    uint64_t written = sizeof(fileHeader) +
+                       (uint64_t) g->players * sizeof(fileMember);
+    uint64_t size = g->board.size;
+
+    return writeZeros(file, header.boardOffset - written) &&
+           fwrite(g->board.nodes, sizeof(Node), size, file) == size;
+}
+
+bool syncGame(gamma_t *g) {
+    if (g->board.mapped == NULL)
+        return true;
+
+    fileHeader header = headerOf(g, FILE_LAYOUT_TILES);
+    memcpy(g->board.head, &header, sizeof(fileHeader));
+
+    for (uint32_t i = 0; i < g->players; i++)
+        storeMember(g, i + 1);
+
+    return syncBoard(&g->board);
+}
+
+void storeMember(gamma_t *g, uint32_t player) {
+    if (g->board.mapped != NULL)
+        *mappedMember(g, player) = memberOf(g, player);
+}
+
+bool readHeader(fileHeader *header, FILE *file) {
+    if (fread(header, sizeof(fileHeader), 1, file) != 1)
+        return false;
+
+    uint64_t size = (uint64_t) header->width * (uint64_t) header->height;
+
+    return memcmp(header->magic, FILE_MAGIC, sizeof(header->magic)) == 0 &&
+           header->version == FILE_VERSION &&
+           header->byteOrder == FILE_BYTE_ORDER &&
+           header->nodeSize == sizeof(Node) &&
+           header->memberSize == sizeof(fileMember) &&
+           (header->layout == FILE_LAYOUT_ROWS ||
+            header->layout == FILE_LAYOUT_TILES) &&
+           header->available <= size &&
+           header->boardOffset == boardOffsetOf(header->players);
+}
+
+static bool readMembers(gamma_t *g, FILE *file) {
+    for (uint32_t i = 0; i < g->players; i++) {
+        fileMember saved;
+        if (fread(&saved, sizeof(fileMember), 1, file) != 1 ||
+            saved.id != i + 1 || saved.areas > g->areas ||
+            saved.goldenMoves > g->numGoldenMoves)
+            return false;
+
+        Member m = getPlayer(g, i + 1);
+        m->areas = saved.areas;
+        m->owned = saved.owned;
+        m->surrounding = saved.surrounding;
+        m->goldenMoves = saved.goldenMoves;
+    }
+
+    return true;
+}
+
+static bool checkBoard(gamma_t *g) {
+    uint64_t size = g->board.size;
+    uint64_t available = 0;
+    Board *board = &g->board;
+
+    // every Node's parent has the same owner and bigger rank, so there
+    // are no cycles
+    for (cell_t elem = 0; elem < size; elem++) {
+        Node *node = nodeAt(board, elem);
+        cell_t parent = parentOf(node, elem);
+
+        // read byte may not be a correct bool
+        uint8_t added;
+        memcpy(&added, &node->added, sizeof(added));
+
+        // dense board may have zeros in place of border
+        if (isBorder(board, elem)) {
+            if ((node->owner != BORDER_OWNER && node->owner != 0) ||
+                added != 0 ||
+                parent != elem || node->rank != 0)
+                return false;
+            continue;
+        }
+
+        if (node->owner > g->players || added != 0 || parent >= size)
+            return false;
+
+        if (node->owner == 0) {
+            available++;
+            if (parent != elem || node->rank != 0)
+                return false;
+        }
+        else if (parent != elem &&
+                 (nodeAt(board, parent)->owner != node->owner ||
+                  nodeAt(board, parent)->rank <= node->rank)) {
+            return false;
+        }
+    }
+
+    if (available != g->available)
+        return false;
+
+    // counters are decreased by every field and root found on the board,
+    // surrounding by every empty field once for each nearby player
+    for (cell_t elem = 0; elem < size; elem++) {
+        if (isBorder(board, elem))
+            continue;
+
+        if (nodeAt(board, elem)->owner == 0) {
+            moveOnEmpty(g, fieldX(g, elem), fieldY(g, elem), true);
+            continue;
+        }
+
+        uint32_t owner = nodeAt(board, elem)->owner;
+        Member m = getPlayer(g, owner);
+        if (m->owned == 0)
+            return false;
+        m->owned--;
+
+        if (parentOf(nodeAt(board, elem), elem) == elem) {
+            if (m->areas == 0)
+                return false;
+            m->areas--;
+        }
+
+        cell_t arr[4];
+        nearbyCells(g, arr, elem);
+        for (int i = 0; i < 4; i++)
+            if (nodeAt(board, arr[i])->owner == owner &&
+                !sameRoot(board, elem, arr[i]))
+                return false;
+    }
+
+    bool output = true;
+    for (uint32_t i = 0; i < g->players; i++) {
+        Member m = getPlayer(g, i + 1);
+        output = output && m->owned == 0 && m->areas == 0 &&
+                 m->surrounding == 0;
+    }
+
+    return output;
+}
+
+bool readGame(gamma_t *g, const fileHeader *header, FILE *file) {
+    uint64_t size = g->board.size;
+    uint64_t read = sizeof(fileHeader) +
+                    (uint64_t) g->players * sizeof(fileMember);
+
+    g->numGoldenMoves = header->numGoldenMoves;
+    g->available = header->available;
+
+    if (header->layout != FILE_LAYOUT_ROWS || g->board.nodes == NULL ||
+        !readMembers(g, file) ||
+        !skipBytes(file, header->boardOffset - read) ||
+        fread(g->board.nodes, sizeof(Node), size, file) != size ||
+        !checkGame(g))
+        return false;
+
+    // every page was written by reading
+    writeBorder(&g->board);
+    return true;
+}
+
+bool openGame(gamma_t *g, const fileHeader *header, FILE *file) {
+    g->numGoldenMoves = header->numGoldenMoves;
+    g->available = header->available;
+
+    // moves made after the last sync are already on the mapped board
+    return header->layout == FILE_LAYOUT_TILES && g->board.mapped != NULL &&
+           readMembers(g, file) && countGame(g) && checkGame(g);
+}
+
+static bool countGame(gamma_t *g) {
+    uint64_t size = g->board.size;
+
+    g->available = 0;
+    for (uint32_t i = 0; i < g->players; i++) {
+        Member m = getPlayer(g, i + 1);
+        m->areas = 0;
+        m->owned = 0;
+        m->surrounding = 0;
+    }
+
+    for (cell_t elem = 0; elem < size; elem++) {
+        if (isBorder(&g->board, elem))
+            continue;
+
+        Node *node = nodeAt(&g->board, elem);
+        if (node->owner > g->players)
+            return false;
+
+        if (node->owner == 0) {
+            g->available++;
+            moveOnEmpty(g, fieldX(g, elem), fieldY(g, elem), false);
+            continue;
+        }
+
+        Member m = getPlayer(g, node->owner);
+        m->owned++;
+        m->areas += parentOf(node, elem) == elem;
+    }
+
+    bool output = true;
+    for (uint32_t i = 0; i < g->players; i++)
+        output = output && getPlayer(g, i + 1)->areas <= g->areas;
+
+    return output;
+}
+
+static bool checkGame(gamma_t *g) {
+    // checkBoard() used counters up, they are equal to counted again
+    if (!checkBoard(g) || !countGame(g))
+        return false;
+
+    addAllCandidates(g);
+    return true;
+}
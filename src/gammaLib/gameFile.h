@@ -0,0 +1,157 @@
+/** @file
+ * Interface of binary files with saved games.
+ *
+ * File begins with fileHeader, then there is one fileMember for every
+ * player and the board, which is array of Nodes row after row together
+ * with border fields, which may be zeros, or tiles of file board without
+ * border. Board begins at offset divisible by FILE_ALIGNMENT counted from
+ * the beginning of file, so it can be mapped to memory and used in place.
+ * Numbers are written in byte order of machine that saved game.
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+#ifndef GAMMA_GAMEFILE_H
+#define GAMMA_GAMEFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * Bytes that begin every file with saved game.
+ */
+#define FILE_MAGIC "GAMMASAV"
+
+/**
+ * Version of file format.
+ */
+#define FILE_VERSION 4
+
+/**
+ * Number written in file to check byte order.
+ */
+#define FILE_BYTE_ORDER 0x01020304u
+
+/**
+ * Alignment of board in file, size of memory page.
+ */
+#define FILE_ALIGNMENT 4096
+
+/**
+ * Layout of board written row after row.
+ */
+#define FILE_LAYOUT_ROWS 0
+
+/**
+ * Layout of board written in tiles of file board.
+ */
+#define FILE_LAYOUT_TILES 1
+
+/**
+ * Game structure.
+ */
+typedef struct gamma gamma_t;
+
+/** @brief Beginning of file with saved game.
+ */
+struct fileHeader {
+    char magic[8];              /**< FILE_MAGIC without '\0' */
+    uint32_t version;           /**< FILE_VERSION */
+    uint32_t byteOrder;         /**< FILE_BYTE_ORDER */
+    uint32_t nodeSize;          /**< Size of Node */
+    uint32_t memberSize;        /**< Size of fileMember */
+
+    uint32_t width;             /**< Game width */
+    uint32_t height;            /**< Game height */
+    uint32_t players;           /**< Number of players */
+    uint32_t areas;             /**< Maximal number of areas */
+    uint32_t numGoldenMoves;    /**< Maximal number of golden moves */
+    uint32_t layout;            /**< FILE_LAYOUT_ROWS or FILE_LAYOUT_TILES */
+    uint64_t available;         /**< Number of empty fields */
+
+    uint64_t boardOffset;       /**< Offset of board in file */
+};
+
+/**
+ * Beginning of file with saved game.
+ */
+typedef struct fileHeader fileHeader;
+
+/** @brief Counters of player in file.
+ */
+struct fileMember {
+    uint32_t id;                /**< Player's id */
+    uint32_t areas;             /**< Number of owned areas */
+    uint64_t owned;             /**< Number of owned fields */
+    uint64_t surrounding;       /**< Number of empty fields surrounding */
+    uint32_t goldenMoves;       /**< Used golden moves */
+    uint32_t reserved;          /**< Zero */
+};
+
+/**
+ * Counters of player in file.
+ */
+typedef struct fileMember fileMember;
+
+/** @brief Writes game to file.
+ * @param g - current game
+ * @param file - file opened for writing
+ * @return false if board isn't dense or game wasn't written else true
+ */
+bool writeGame(gamma_t *g, FILE *file);
+
+/** @brief Writes game with file board to its file.
+ * Puts header and players' counters in mapped head of board and writes
+ * them together with changed Nodes. Does nothing for other boards.
+ * @param g - current game
+ * @return true if game was written or has other board else false
+ */
+bool syncGame(gamma_t *g);
+
+/** @brief Puts counters of player in mapped head of file board.
+ * Keeps used golden moves in file between syncs, other counters are
+ * counted again from the board when file is opened. Does nothing for
+ * other boards.
+ * @param g - current game
+ * @param player - player's id
+ */
+void storeMember(gamma_t *g, uint32_t player);
+
+/** @brief Reads beginning of file.
+ * @param header - memory for read header
+ * @param file - file opened for reading
+ * @return true if header was read and describes correct game else false
+ */
+bool readHeader(fileHeader *header, FILE *file);
+
+/** @brief Reads rest of file after readHeader().
+ * Fills new game @p g made with parameters from @p header and checks
+ * that read fields and players describe correct game. Board has to be
+ * written row after row.
+ * @param g - new game
+ * @param header - header read from @p file
+ * @param file - file opened for reading
+ * @return true if game was read else false
+ */
+bool readGame(gamma_t *g, const fileHeader *header, FILE *file);
+
+/** @brief Reads rest of file of file board after readHeader().
+ * Reads players' used golden moves to new game @p g, whose board was
+ * mapped from the same file, counts the rest of counters from the board,
+ * which may be newer than the last sync, and checks that they describe
+ * correct game.
+ * @param g - new game with file board
+ * @param header - header read from @p file
+ * @param file - file opened for reading
+ * @return true if game was read else false
+ */
+bool openGame(gamma_t *g, const fileHeader *header, FILE *file);
+
+/** @brief Gives offset of board in file.
+ * @param players - number of players
+ * @return offset of board, divisible by FILE_ALIGNMENT
+ */
+uint64_t boardOffsetOf(uint32_t players);
+
+#endif //GAMMA_GAMEFILE_H
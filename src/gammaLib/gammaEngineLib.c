@@ -9,110 +9,148 @@
 #include <stdio.h>
 
 /** @brief Builds connections of fields.
- * Build areas of fields owned by @p id player starting from Node @p center
+ * Build area of fields owned by @p id player starting from field @p center
  * @param g - current game
- * @param center - Node that we are merging with
- * @param elem - current field
+ * @param center - index of field that we are merging with
  * @param id - player id
  */
-static void buildArea(gamma_t *g, Node *center, Node *elem, uint32_t id);
+static void buildArea(gamma_t *g, cell_t center, uint32_t id);
+
+/** @brief Clears field and marks it as added.
+ * Does it only if field @p elem is owned by @p id and wasn't added yet.
+ * @param g - current game
+ * @param elem - index of field
+ * @param id - player id
+ * @return true if field was cleared else false
+ */
+static bool clearField(gamma_t *g, cell_t elem, uint32_t id);
+
+/** @brief Merges field with area.
+ * Merges field @p elem owned by @p id with area of @p center, if it was
+ * deleted before or belongs to other area.
+ * @param g - current game
+ * @param center - index of field that we are merging with
+ * @param elem - index of field
+ * @param id - player id
+ * @return true if field was merged else false
+ */
+static bool buildField(gamma_t *g, cell_t center, cell_t elem, uint32_t id);
 
 /** @brief Load 4 nearby fields
  * @param g - current game
- * @param arr - Node * array with size equal to 4
+ * @param arr - cell_t array with size equal to 4
  * @param x - first coordinate
  * @param y - second coordinate
  */
-static void nearbyFields(gamma_t *g, Node *arr[], uint32_t x, uint32_t y);
+static void nearbyFields(gamma_t *g, cell_t arr[], uint32_t x, uint32_t y);
 
-/** @brief Check if Node is empty.
- * Check @p elem.
- * @param elem - Node being checked
- * @return false if node is not empty or its NULL else true
+/** @brief Check if field is empty.
+ * Check field @p elem.
+ * @param g - current game
+ * @param elem - index of field being checked
+ * @return true if field is empty else false
  */
-static bool isEmptyNode(Node *elem);
+static bool isEmptyCell(gamma_t *g, cell_t elem);
 
 /** @brief Checks if player owns field.
  * Checks if @p player owns @p elem.
  * @param g - current game
  * @param player - Member's id
- * @param elem - field
- * @return true if @p elem is not NULL and player owns field else false
+ * @param elem - index of field
+ * @return true if player owns field else false
  */
-static bool isMineNode(gamma_t *g, uint32_t player, Node *elem);
+static bool isMineCell(gamma_t *g, uint32_t player, cell_t elem);
 
 /** @brief Give bottom field.
  * Give bottom field of field at (@p x, @p y)
  * @param g - current game
  * @param x - first coordinate
  * @param y - second coordinate
- * @return bottom field or NULL.
+ * @return index of bottom field, which may be a border field.
  */
-static Node *getDown(gamma_t *g, uint32_t x, uint32_t y);
+static cell_t getDown(gamma_t *g, uint32_t x, uint32_t y);
 
 /** @brief Give upper field.
  * Give upper field of field at (@p x, @p y)
  * @param g - current game
  * @param x - first coordinate
  * @param y - second coordinate
- * @return upper field or NULL.
+ * @return index of upper field, which may be a border field.
  */
-static Node *getUp(gamma_t *g, uint32_t x, uint32_t y);
+static cell_t getUp(gamma_t *g, uint32_t x, uint32_t y);
 
 /** @brief Give left field.
  * Give left field of field at (@p x, @p y)
  * @param g - current game
  * @param x - first coordinate
  * @param y - second coordinate
- * @return left field or NULL.
+ * @return index of left field, which may be a border field.
  */
-static Node *getLeft(gamma_t *g, uint32_t x, uint32_t y);
+static cell_t getLeft(gamma_t *g, uint32_t x, uint32_t y);
 
 /** @brief Give right field.
  * Give right field of field at (@p x, @p y)
  * @param g - current game
  * @param x - first coordinate
  * @param y - second coordinate
- * @return right field or NULL.
+ * @return index of right field, which may be a border field.
+ */
+static cell_t getRight(gamma_t *g, uint32_t x, uint32_t y);
+
+/** @brief Remembers golden move candidate and compacts candidates.
+ * @param g - current game
+ * @param player - Member's id
+ * @param elem - index of field of other player next to @p player's field
+ */
+static void addPlayerCandidate(gamma_t *g, uint32_t player, cell_t elem);
+
+/** @brief Removes outdated and repeated candidates of player.
+ * Marks kept fields as added for a moment to find repeated ones.
+ * @param g - current game
+ * @param player - Member's id
  */
-static Node *getRight(gamma_t *g, uint32_t x, uint32_t y);
+static void compactCandidates(gamma_t *g, uint32_t player);
 
 /** @brief Set nearby field added to false
  * @param g - current game
  * @param player - Member's id
- * @param arr - array ofisEmptyNode nearby fields
+ * @param arr - array of indexes of nearby fields
  */
-static void setNearbyFalse(gamma_t *g, uint32_t player, Node **arr);
+static void setNearbyFalse(gamma_t *g, uint32_t player, cell_t *arr);
 
 /** @brief Get owner of field.
- * Get owner of field at (@p x, @p y) in game @p g
+ * Get owner of taken field @p elem in game @p g
  * @param g - current game
- * @param x - first coordinate
- * @param y - second coordinate
- * @return Owner of field (@p x, @p y)
+ * @param elem - index of field
+ * @return Owner of field @p elem
  */
-static inline Member getOwnerPlayer(gamma_t *g, uint32_t x, uint32_t y);
+static inline Member getCellPlayer(gamma_t *g, cell_t elem);
 
 inline bool positive(uint32_t num) {
     return num > 0;
 }
 
-bool initMembers(Member *members, uint32_t players) {
-    for (unsigned int i = 0; i < players; i++) {
-        members[i] = newMember(i + 1);
-        if (members[i] == NULL)
-            return false;
-    }
-    return true;
+void initMembers(member *members, uint32_t players) {
+    for (uint32_t i = 0; i < players; i++)
+        initMember(&members[i], i + 1);
 }
 
-bool initBoard(Node ***board, uint32_t width, uint32_t height) {
-    for (uint32_t i = 0; i < width; i++)
-        for (uint32_t j = 0; j < height; j++) {
-            board[i][j] = newRoot(0, i, j);
-            if (board[i][j] == NULL)
-                return false;
-        }
+bool reserveWorkList(gamma_t *g, uint64_t size) {
+    if (g->workListSize >= size)
+        return true;
+
+    if (size < 2 * g->workListSize)
+        size = 2 * g->workListSize;
+
+    if (size > SIZE_MAX / sizeof(cell_t))
+        return false;
+
+    cell_t *workList = realloc(g->workList, size * sizeof(cell_t));
+    if (workList == NULL)
+        return false;
+
+    g->workList = workList;
+    g->workListSize = size;
     return true;
 }
 
@@ -127,41 +165,52 @@ inline bool wrongCoordinates(gamma_t *g, uint32_t x, uint32_t y) {
 }
 
 inline bool isEmpty(gamma_t *g, uint32_t x, uint32_t y) {
-    return g->board[x][y]->owner == 0;
+    return getField(g, x, y)->owner == 0;
 }
 
 inline bool hasGoldenMoves(gamma_t *g, uint32_t player) {
     return getPlayer(g, player)->goldenMoves < g->numGoldenMoves;
 }
 
-static bool isEmptyNode(Node *elem) {
-    if (elem == NULL)
-        return false;
-    else
-        return elem->owner == 0;
+static bool isEmptyCell(gamma_t *g, cell_t elem) {
+    return nodeAt(&g->board, elem)->owner == 0;
 }
 
-bool isMineNode(gamma_t *g, uint32_t player, Node *elem) {
-    if (elem == NULL)
-        return false;
-    else
-        return elem->owner == g->members[player - 1]->id;
+static bool isMineCell(gamma_t *g, uint32_t player, cell_t elem) {
+    return nodeAt(&g->board, elem)->owner == g->members[player - 1].id;
+}
+
+inline bool isTakenCell(gamma_t *g, cell_t elem) {
+    // empty fields and border wrap around to numbers not less than players
+    return nodeAt(&g->board, elem)->owner - 1u < g->players;
 }
 
 inline Member getPlayer(gamma_t *g, uint32_t player) {
-    return g->members[player - 1];
+    return &g->members[player - 1];
+}
+
+inline cell_t getCell(gamma_t *g, uint32_t x, uint32_t y) {
+    return (cell_t) (y + 1) * g->board.stride + x + 1;
 }
 
 inline Node *getField(gamma_t *g, uint32_t x, uint32_t y) {
-    return g->board[x][y];
+    return nodeAt(&g->board, getCell(g, x, y));
+}
+
+inline uint32_t fieldX(gamma_t *g, cell_t elem) {
+    return elem % g->board.stride - 1;
+}
+
+inline uint32_t fieldY(gamma_t *g, cell_t elem) {
+    return elem / g->board.stride - 1;
 }
 
 inline bool isMine(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
-    return g->board[x][y]->owner == getPlayer(g, player)->id;
+    return getField(g, x, y)->owner == getPlayer(g, player)->id;
 }
 
 inline uint32_t getAreas(gamma_t *g, uint32_t player) {
-    return g->members[player - 1]->areas;
+    return g->members[player - 1].areas;
 }
 
 void takeField(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
@@ -177,65 +226,62 @@ void resetField(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
 }
 
 inline uint32_t getOwner(gamma_t *g, uint32_t x, uint32_t y) {
-    return g->board[x][y]->owner;
+    return getField(g, x, y)->owner;
 }
 
-inline Node *getDown(gamma_t *g, uint32_t x, uint32_t y) {
-    return y == 0 ? NULL : g->board[x][y - 1];
+static inline cell_t getDown(gamma_t *g, uint32_t x, uint32_t y) {
+    return getCell(g, x, y) - g->board.stride;
 }
 
-inline Node *getUp(gamma_t *g, uint32_t x, uint32_t y) {
-    return y + 1 == g->height ? NULL : g->board[x][y + 1];
+static inline cell_t getUp(gamma_t *g, uint32_t x, uint32_t y) {
+    return getCell(g, x, y) + g->board.stride;
 }
 
-inline Node *getLeft(gamma_t *g, uint32_t x, uint32_t y) {
-    return x == 0 ? NULL : g->board[x - 1][y];
+static inline cell_t getLeft(gamma_t *g, uint32_t x, uint32_t y) {
+    return getCell(g, x, y) - 1;
 }
 
-inline Node *getRight(gamma_t *g, uint32_t x, uint32_t y) {
-    return x + 1 == g->width ? NULL : g->board[x + 1][y];
+static inline cell_t getRight(gamma_t *g, uint32_t x, uint32_t y) {
+    return getCell(g, x, y) + 1;
 }
 
-static inline Member getOwnerPlayer(gamma_t *g, uint32_t x, uint32_t y) {
-    return getPlayer(g, getOwner(g, x, y));
+static inline Member getCellPlayer(gamma_t *g, cell_t elem) {
+    return getPlayer(g, nodeAt(&g->board, elem)->owner);
 }
 
 void moveOnEmpty(gamma_t *g, uint32_t x, uint32_t y, bool sub) {
 
     int change = sub ? -1 : 1;
 
-    Node *arr[4];
+    cell_t arr[4];
     nearbyFields(g, arr, x, y);
-    uint32_t newX[4] = {x - 1, x, x + 1, x};
-    uint32_t newY[4] = {y, y + 1, y, y - 1};
 
     for (int i = 0; i < 4; i++) {
-        if (arr[i] != NULL && !isEmptyNode(arr[i])
-            && !getOwnerPlayer(g, newX[i], newY[i])->changedSurrounding) {
+        if (isTakenCell(g, arr[i])
+            && !getCellPlayer(g, arr[i])->changedSurrounding) {
 
-            getOwnerPlayer(g, newX[i], newY[i])->changedSurrounding = true;
-            getOwnerPlayer(g, newX[i], newY[i])->surrounding += change;
+            getCellPlayer(g, arr[i])->changedSurrounding = true;
+            getCellPlayer(g, arr[i])->surrounding += change;
         }
     }
 
     for (int i = 0; i < 4; i++) {
-        if (arr[i] != NULL && !isEmptyNode(arr[i]) &&
-            getOwnerPlayer(g, newX[i], newY[i])->changedSurrounding)
-            getOwnerPlayer(g, newX[i], newY[i])->changedSurrounding = false;
+        if (isTakenCell(g, arr[i]) &&
+            getCellPlayer(g, arr[i])->changedSurrounding)
+            getCellPlayer(g, arr[i])->changedSurrounding = false;
     }
 }
 
 uint32_t numEmpty(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
     uint32_t empty = 0;
 
-    uint32_t newX[4] = {x - 1, x, x + 1, x};
-    uint32_t newY[4] = {y, y + 1, y, y - 1};
-    Node *arr[4];
+    cell_t arr[4];
     nearbyFields(g, arr, x, y);
 
     for (int i = 0; i < 4; i++) {
-        if (arr[i] != NULL && isEmptyNode(arr[i]))
-            empty += numNeighbours(g, player, newX[i], newY[i]) == 1;
+        if (isEmptyCell(g, arr[i]))
+            empty += numNeighbours(g, player, fieldX(g, arr[i]),
+                                   fieldY(g, arr[i])) == 1;
     }
 
 
@@ -245,25 +291,118 @@ uint32_t numEmpty(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
 uint32_t numNeighbours(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
     uint32_t neighbours = 0;
 
-    neighbours += isMineNode(g, player, getLeft(g, x, y));
-    neighbours += isMineNode(g, player, getRight(g, x, y));
-    neighbours += isMineNode(g, player, getUp(g, x, y));
-    neighbours += isMineNode(g, player, getDown(g, x, y));
+    neighbours += isMineCell(g, player, getLeft(g, x, y));
+    neighbours += isMineCell(g, player, getRight(g, x, y));
+    neighbours += isMineCell(g, player, getUp(g, x, y));
+    neighbours += isMineCell(g, player, getDown(g, x, y));
 
     return neighbours;
 }
 
-static void nearbyFields(gamma_t *g, Node *arr[], uint32_t x, uint32_t y) {
+static void nearbyFields(gamma_t *g, cell_t arr[], uint32_t x, uint32_t y) {
     arr[0] = getLeft(g, x, y);
     arr[1] = getUp(g, x, y);
     arr[2] = getRight(g, x, y);
     arr[3] = getDown(g, x, y);
 }
 
-static void setNearbyFalse(gamma_t *g, uint32_t player, Node **arr) {
+void addCandidates(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
+    cell_t arr[4];
+    nearbyFields(g, arr, x, y);
+
+    for (int i = 0; i < 4; i++) {
+        if (!isTakenCell(g, arr[i]) || isMineCell(g, player, arr[i]))
+            continue;
+
+        if (hasGoldenMoves(g, player))
+            addPlayerCandidate(g, player, arr[i]);
+
+        uint32_t owner = nodeAt(&g->board, arr[i])->owner;
+        if (hasGoldenMoves(g, owner))
+            addPlayerCandidate(g, owner, getCell(g, x, y));
+    }
+}
+
+static void addPlayerCandidate(gamma_t *g, uint32_t player, cell_t elem) {
+    Member m = getPlayer(g, player);
+    addCandidate(m, elem);
+
+    // outdated candidates may become valid again after rollback
+    if (m->candidatesSize >= CANDIDATES_MIN &&
+        m->candidatesSize >= 2 * m->candidatesCompacted &&
+        !g->journal.active)
+        compactCandidates(g, player);
+}
+
+static void compactCandidates(gamma_t *g, uint32_t player) {
+    Member m = getPlayer(g, player);
+    uint64_t kept = 0;
+
+    for (uint64_t i = 0; i < m->candidatesSize; i++) {
+        cell_t elem = m->candidates[i];
+        if (!isCandidate(g, player, elem) || nodeAt(&g->board, elem)->added)
+            continue;
+
+        nodeAt(&g->board, elem)->added = true;
+        m->candidates[kept++] = elem;
+    }
+
+    for (uint64_t i = 0; i < kept; i++)
+        nodeAt(&g->board, m->candidates[i])->added = false;
+
+    m->candidatesSize = kept;
+    m->candidatesCompacted = kept;
+}
+
+void useGoldenMove(gamma_t *g, uint32_t player) {
+    getPlayer(g, player)->goldenMoves++;
+
+    if (!hasGoldenMoves(g, player))
+        dropCandidates(getPlayer(g, player));
+}
+
+void addAllCandidates(gamma_t *g) {
+    for (cell_t elem = 0; elem < g->board.size; elem++) {
+        if (!isTakenCell(g, elem))
+            continue;
+
+        uint32_t owner = nodeAt(&g->board, elem)->owner;
+        if (!hasGoldenMoves(g, owner))
+            continue;
+
+        cell_t arr[4];
+        nearbyCells(g, arr, elem);
+        for (int i = 0; i < 4; i++)
+            if (isTakenCell(g, arr[i]) && !isMineCell(g, owner, arr[i]))
+                addPlayerCandidate(g, owner, arr[i]);
+    }
+}
+
+bool isCandidate(gamma_t *g, uint32_t player, cell_t elem) {
+    if (!isTakenCell(g, elem) || isMineCell(g, player, elem))
+        return false;
+
+    cell_t arr[4];
+    nearbyCells(g, arr, elem);
+    for (int i = 0; i < 4; i++)
+        if (isMineCell(g, player, arr[i]))
+            return true;
+
+    return false;
+}
+
+void nearbyCells(gamma_t *g, cell_t arr[], cell_t elem) {
+    // border around board makes neighbours of every field valid indexes
+    arr[0] = elem - 1;
+    arr[1] = elem + g->board.stride;
+    arr[2] = elem + 1;
+    arr[3] = elem - g->board.stride;
+}
+
+static void setNearbyFalse(gamma_t *g, uint32_t player, cell_t *arr) {
     for (int i = 0; i < 4; i++)
-        if (arr[i] != NULL && isMineNode(g, player, arr[i])) {
-            setRootAdded(arr[i], false);
+        if (isMineCell(g, player, arr[i])) {
+            setRootAdded(&g->board, arr[i], false);
         }
 }
 
@@ -271,67 +410,189 @@ uint32_t areasChange(gamma_t *g, uint32_t player,
                      uint32_t x, uint32_t y, bool middle) {
 
     uint32_t output = 0;
-    Node *arr[4]; // nearby fields
+    cell_t arr[4]; // nearby fields
     nearbyFields(g, arr, x, y);
-    Node *mine = NULL;
+    cell_t mine = NO_CELL;
 
     for (int i = 0; i < 4; i++) {
-        if (arr[i] != NULL && !isRootAdded(arr[i]) &&
-            isMineNode(g, player, arr[i])) {
+        // journal remembers Nodes only on the way to roots
+        if (isMineCell(g, player, arr[i]) && !g->journal.active)
+            find(&g->board, arr[i]);
 
-            if (mine == NULL)
+        if (isMineCell(g, player, arr[i]) &&
+            !isRootAdded(&g->board, arr[i])) {
+
+            if (mine == NO_CELL)
                 mine = arr[i];
             else if (middle) {
                 // prevent arr[i] becoming a root and mine->added remaining true
-                setRootAdded(mine, false);
-                merge(mine, arr[i]);
+                setRootAdded(&g->board, mine, false);
+                merge(&g->board, mine, arr[i]);
             }
 
-            setRootAdded(arr[i], true);
+            setRootAdded(&g->board, arr[i], true);
             output++;
         }
     }
 
     setNearbyFalse(g, player, arr);
     if (middle) {
-        merge(mine, getField(g, x, y));
+        merge(&g->board, mine, getCell(g, x, y));
     }
 
     return output - 1;
 }
 
-void clearRelations(gamma_t *g, Node *elem, uint32_t id) {
-    if (elem == NULL)
+static bool clearField(gamma_t *g, cell_t elem, uint32_t id) {
+    Node *node = nodeAt(&g->board, elem);
+    if (node->added || node->owner != id)
+        return false;
+
+    journalCell(g, elem);
+    clearNodeData(&g->board, elem);
+    node->added = true;
+    return true;
+}
+
+void clearRelations(gamma_t *g, cell_t elem, uint32_t id) {
+    if (!clearField(g, elem, id))
         return;
-    if (!elem->added && elem->owner == id) {
-        clearNodeData(elem);
-        elem->added = true;
-
-        clearRelations(g, getLeft(g, elem->x, elem->y), id);
-        clearRelations(g, getUp(g, elem->x, elem->y), id);
-        clearRelations(g, getRight(g, elem->x, elem->y), id);
-        clearRelations(g, getDown(g, elem->x, elem->y), id);
+
+    uint64_t size = 0;
+    g->workList[size++] = elem;
+
+    while (size > 0) {
+        elem = g->workList[--size];
+
+        cell_t arr[4];
+        nearbyCells(g, arr, elem);
+
+        for (int i = 0; i < 4; i++)
+            if (clearField(g, arr[i], id))
+                g->workList[size++] = arr[i];
     }
 }
 
-static void buildArea(gamma_t *g, Node *center, Node *elem, uint32_t id) {
-    if (elem == NULL)
-        return;
+static bool buildField(gamma_t *g, cell_t center, cell_t elem, uint32_t id) {
+    if (nodeAt(&g->board, elem)->owner != id)
+        return false;
+
     // was deleted before or connects to other area
-    if ((elem->added || !sameRoot(center, elem)) && elem->owner == id) {
-        merge(center, elem);
-        elem->added = false;
-
-        buildArea(g, center, getLeft(g, elem->x, elem->y), id);
-        buildArea(g, center, getUp(g, elem->x, elem->y), id);
-        buildArea(g, center, getRight(g, elem->x, elem->y), id);
-        buildArea(g, center, getDown(g, elem->x, elem->y), id);
+    if (!nodeAt(&g->board, elem)->added && sameRoot(&g->board, center, elem))
+        return false;
+
+    merge(&g->board, center, elem);
+    nodeAt(&g->board, elem)->added = false;
+    return true;
+}
+
+static void buildArea(gamma_t *g, cell_t center, uint32_t id) {
+    if (!buildField(g, center, center, id))
+        return;
+
+    uint64_t size = 0;
+    g->workList[size++] = center;
+
+    while (size > 0) {
+        cell_t elem = g->workList[--size];
+
+        cell_t arr[4];
+        nearbyCells(g, arr, elem);
+
+        for (int i = 0; i < 4; i++)
+            if (buildField(g, center, arr[i], id))
+                g->workList[size++] = arr[i];
     }
 }
 
 void buildConnected(gamma_t *g, uint32_t player, uint32_t x, uint32_t y) {
-    buildArea(g, getLeft(g, x, y), getLeft(g, x, y), player);
-    buildArea(g, getUp(g, x, y), getUp(g, x, y), player);
-    buildArea(g, getRight(g, x, y), getRight(g, x, y), player);
-    buildArea(g, getDown(g, x, y), getDown(g, x, y), player);
+    buildArea(g, getLeft(g, x, y), player);
+    buildArea(g, getUp(g, x, y), player);
+    buildArea(g, getRight(g, x, y), player);
+    buildArea(g, getDown(g, x, y), player);
+}
+
+void markChanged(gamma_t *g, uint32_t x, uint32_t y) {
+    cell_t arr[4];
+    nearbyFields(g, arr, x, y);
+    g->moves++;
+
+    if (!isEmpty(g, x, y))
+        getPlayer(g, getOwner(g, x, y))->changed = g->moves;
+
+    for (int i = 0; i < 4; i++)
+        if (isTakenCell(g, arr[i]))
+            getPlayer(g, nodeAt(&g->board, arr[i])->owner)->changed = g->moves;
+}
+
+void watchOwner(gamma_t *g, uint32_t player, uint32_t owner) {
+    Member watched = getPlayer(g, owner);
+
+    if (watched->watchStamp != g->lookups) {
+        watched->watchStamp = g->lookups;
+        addWatched(getPlayer(g, player), owner);
+    }
+}
+
+bool isGoldenKnown(gamma_t *g, uint32_t player) {
+    Member p = getPlayer(g, player);
+    if (!p->goldenKnown || p->changed > p->checked || p->checked < g->reverted)
+        return false;
+
+    for (uint64_t i = 0; i < p->watchedSize; i++)
+        if (getPlayer(g, p->watched[i])->changed > p->checked)
+            return false;
+
+    return true;
+}
+
+uint32_t fieldLengthOf(uint32_t players) {
+    uint32_t numberLength = 1;
+    while (players >= 10) {
+        players /= 10;
+        numberLength++;
+    }
+
+    // one extra free space
+    if (numberLength > 1)
+        numberLength++;
+
+    return numberLength;
+}
+
+void initDigits(char *digits, uint32_t size, uint32_t fieldLength) {
+    for (uint32_t id = 0; id < size; id++) {
+        char *field = digits + (uint64_t) id * fieldLength;
+        char *end = field + fieldLength;
+        uint32_t rest = id;
+
+        if (id == 0)
+            *--end = '.';
+
+        while (rest > 0) {
+            *--end = (char) ('0' + rest % 10);
+            rest /= 10;
+        }
+
+        memset(field, ' ', end - field);
+    }
+}
+
+char *writeField(gamma_t *g, char *out, uint32_t owner) {
+    uint32_t fieldLength = g->fieldLength;
+
+    if (owner < g->digitsSize) {
+        memcpy(out, g->digits + (uint64_t) owner * fieldLength, fieldLength);
+        return out + fieldLength;
+    }
+
+    // ids that are too big to keep are written from the last digit
+    char *end = out + fieldLength;
+    while (owner > 0) {
+        *--end = (char) ('0' + owner % 10);
+        owner /= 10;
+    }
+    memset(out, ' ', end - out);
+
+    return out + fieldLength;
 }
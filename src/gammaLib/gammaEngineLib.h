@@ -8,10 +8,37 @@
 #define GAMMA_GAMMAENGINELIB_H
 
 #include "../playerLib/player.h"
+#include "../boardLib/board.h"
+#include "areaSearch.h"
+#include "journal.h"
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
 
+/**
+ * Maximal number of player ids, including empty field, kept already written.
+ */
+#define DIGITS_LIMIT 4096
+
+/**
+ * Number of moves ahead whose fields are prefetched by bulk moves.
+ */
+#define PREFETCH_DISTANCE 8
+
+/**
+ * Number of golden move candidates of player that are kept without
+ * compaction.
+ */
+#define CANDIDATES_MIN 64
+
+#if defined(__GNUC__)
+/** Asks processor to load memory at @p address into cache */
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+/** Asks processor to load memory at @p address into cache */
+#define PREFETCH(address) ((void) (address))
+#endif
+
 /** @brief Structure that holds gama data.
  *
  * Remember gama data.
@@ -24,8 +51,22 @@ struct gamma {
 
     uint32_t numGoldenMoves;    /**< Maximal number of golden moves */
     uint64_t available;         /**< Number of empty fields */
-    Member *members;            /**< Array of players */
-    Node ***board;              /**< 2D Array of fields */
+    member *members;            /**< Array of players */
+    Board board;                /**< Fields stored row after row */
+
+    cell_t *workList;           /**< Reusable buffer for area traversals */
+    uint64_t workListSize;      /**< Capacity of workList */
+    Search search;              /**< Reusable memory of golden move searches */
+
+    uint64_t moves;             /**< Number of moves that changed the board */
+    uint64_t lookups;           /**< Number of golden move look ups */
+    uint64_t reverted;          /**< Move number given to the last rollback */
+    Journal journal;            /**< Changes made during transaction */
+
+    uint32_t fieldLength;       /**< Length of every field on printed board */
+    uint32_t digitsSize;        /**< Number of ids in digits */
+    char *digits;               /**< Printed fields of ids from 0, every one
+                                     fieldLength long, without '\0' */
 };
 
 /**
@@ -40,21 +81,19 @@ typedef struct gamma gamma_t;
 bool positive(uint32_t num);
 
 /** @brief Initialize all members.
- * Allocates memory for all Members in array
+ * Makes every Member in array a new player
  * @param members - array of members
  * @param players - number of members
- * @return true if init had enough memory else false
  */
-bool initMembers(Member *members, uint32_t players);
+void initMembers(member *members, uint32_t players);
 
-/** @brief Initialize game board.
- * Allocates memory for all fields
- * @param board - allocated memory for new board
- * @param width - board width
- * @param height - board height
- * @return true if init had enough memory else false
+/** @brief Makes sure that work list can hold enough fields.
+ * Grows work list of @p g so that it can hold at least @p size fields.
+ * @param g - current game
+ * @param size - needed capacity
+ * @return true if work list is big enough else false
  */
-bool initBoard(Node ***board, uint32_t width, uint32_t height);
+bool reserveWorkList(gamma_t *g, uint64_t size);
 
 /** @brief Get player from current game.
  * Get player with id @p player from @p g game
@@ -64,6 +103,42 @@ bool initBoard(Node ***board, uint32_t width, uint32_t height);
  */
 Member getPlayer(gamma_t *g, uint32_t player);
 
+/** @brief Give index of field with given coordinates.
+ * @param g - current game
+ * @param x - first coordinate
+ * @param y - second coordinate
+ * @return Index of field in game @p g at (@p x, @p y)
+ */
+cell_t getCell(gamma_t *g, uint32_t x, uint32_t y);
+
+/** @brief Give first coordinate of field.
+ * @param g - current game
+ * @param elem - index of field on the board of @p g
+ * @return first coordinate of @p elem
+ */
+uint32_t fieldX(gamma_t *g, cell_t elem);
+
+/** @brief Give second coordinate of field.
+ * @param g - current game
+ * @param elem - index of field on the board of @p g
+ * @return second coordinate of @p elem
+ */
+uint32_t fieldY(gamma_t *g, cell_t elem);
+
+/** @brief Checks if field is owned by some player.
+ * @param g - current game
+ * @param elem - index of field or border field on the board of @p g
+ * @return false if field is empty or is a border field else true
+ */
+bool isTakenCell(gamma_t *g, cell_t elem);
+
+/** @brief Load 4 nearby fields of field.
+ * @param g - current game
+ * @param arr - cell_t array with size equal to 4
+ * @param elem - index of field
+ */
+void nearbyCells(gamma_t *g, cell_t arr[], cell_t elem);
+
 /** @brief Give field with given coordinates.
  * @param g - current game
  * @param x - first coordinate
@@ -197,14 +272,16 @@ uint32_t areasChange(gamma_t *g, uint32_t player,
 
 /** @brief Clear relations in area.
  *  Clear data in all Nodes in area, mark as added.
+ *  Work list has to be able to hold the whole area.
  * @param g - current game
- * @param elem - initial Node
+ * @param elem - index of initial Node
  * @param id - Member's id
  */
-void clearRelations(gamma_t *g, Node *elem, uint32_t id);
+void clearRelations(gamma_t *g, cell_t elem, uint32_t id);
 
 /** @brief Build areas on nearby fields.
- * Build areas nearby field (@p x, @p y) owned by Member's id @p player
+ * Build areas nearby field (@p x, @p y) owned by Member's id @p player.
+ * Work list has to be able to hold all fields of @p player.
  * @param g - current game
  * @param player - Member's id
  * @param x - first coordinate
@@ -212,4 +289,93 @@ void clearRelations(gamma_t *g, Node *elem, uint32_t id);
  */
 void buildConnected(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
 
+/** @brief Remembers golden move candidates after move.
+ * Field (@p x, @p y) taken by @p player becomes candidate of owners
+ * of nearby fields and their fields become candidates of @p player.
+ * Only players that still have golden moves remember candidates. List
+ * that doubled since it was compacted last time loses outdated and
+ * repeated candidates, unless transaction was started.
+ * @param g - current game
+ * @param player - Member's id, owner of (@p x, @p y)
+ * @param x - first coordinate
+ * @param y - second coordinate
+ */
+void addCandidates(gamma_t *g, uint32_t player, uint32_t x, uint32_t y);
+
+/** @brief Marks that player used golden move.
+ * Player who used all golden moves forgets candidates. If golden move is
+ * rolled back, the player looks for golden move on the whole board.
+ * @param g - current game
+ * @param player - Member's id
+ */
+void useGoldenMove(gamma_t *g, uint32_t player);
+
+/** @brief Remembers golden move candidates of whole board.
+ * Used when board was filled without moves. Only players that still have
+ * golden moves remember candidates.
+ * @param g - current game
+ */
+void addAllCandidates(gamma_t *g);
+
+/** @brief Check if field is still golden move candidate.
+ * @param g - current game
+ * @param player - Member's id
+ * @param elem - index of field
+ * @return true if @p elem belongs to other player and is next to
+ * @p player's field else false
+ */
+bool isCandidate(gamma_t *g, uint32_t player, cell_t elem);
+
+/** @brief Calculates length of field.
+ * Calculates what will be field length in game with @p players players.
+ * @param players - number of players in game
+ * @return length of field
+ */
+uint32_t fieldLengthOf(uint32_t players);
+
+/** @brief Writes printed fields of first ids.
+ * Writes right-aligned ids from 0 to @p size - 1 one after another,
+ * id 0 is written as empty field.
+ * @param digits - memory for @p size fields
+ * @param size - number of ids
+ * @param fieldLength - length of every field
+ */
+void initDigits(char *digits, uint32_t size, uint32_t fieldLength);
+
+/** @brief Writes field.
+ * Writes field of @p owner right-aligned to length of fields of @p g,
+ * without '\0'.
+ * @param g - current game
+ * @param out - memory for field
+ * @param owner - owner's id or 0 if field is empty
+ * @return first char after written field
+ */
+char *writeField(gamma_t *g, char *out, uint32_t owner);
+
+/** @brief Remembers which players' options were changed by move.
+ * Marks owner of (@p x, @p y) and owners of nearby fields as changed
+ * by a new move.
+ * @param g - current game
+ * @param x - first coordinate
+ * @param y - second coordinate
+ */
+void markChanged(gamma_t *g, uint32_t x, uint32_t y);
+
+/** @brief Makes golden move result depend on other player.
+ * Remembered result of @p player is outdated after @p owner is changed.
+ * Every owner is added once per look up.
+ * @param g - current game
+ * @param player - Member's id
+ * @param owner - id of owner of @p player's candidate
+ */
+void watchOwner(gamma_t *g, uint32_t player, uint32_t owner);
+
+/** @brief Check if remembered golden move result is up to date.
+ * @param g - current game
+ * @param player - Member's id
+ * @return true if neither @p player nor players it watches were changed
+ * since result was found else false
+ */
+bool isGoldenKnown(gamma_t *g, uint32_t player);
+
 #endif //GAMMA_GAMMAENGINELIB_H
@@ -0,0 +1,110 @@
+/** @file
+ * Implementation of journal of changes made during transaction.
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+#include "journal.h"
+#include "gammaEngineLib.h"
+#include "gameFile.h"
+
+/**
+ * Initial capacity of journal arrays.
+ */
+#define INITIAL_JOURNAL_SIZE 64
+
+/** @brief Grows array to hold at least @p needed elements.
+ * @param array - pointer to array
+ * @param capacity - pointer to capacity of array
+ * @param needed - needed capacity
+ * @param elemSize - size of one element
+ * @return false if there was not enough memory else true
+ */
+static bool growArray(void **array, uint64_t *capacity, uint64_t needed,
+                      size_t elemSize);
+
+// ----------------------------------------------------------------------------
+
+void initJournal(Journal *j) {
+    *j = (Journal) {NULL, 0, 0, NULL, 0, 0, 0, false};
+}
+
+void freeJournal(Journal *j) {
+    free(j->cells);
+    free(j->members);
+    initJournal(j);
+}
+
+static bool growArray(void **array, uint64_t *capacity, uint64_t needed,
+                      size_t elemSize) {
+    if (needed <= *capacity)
+        return true;
+
+    uint64_t newCapacity = *capacity == 0 ? INITIAL_JOURNAL_SIZE : *capacity;
+    while (newCapacity < needed)
+        newCapacity *= 2;
+
+    if (newCapacity > SIZE_MAX / elemSize)
+        return false;
+
+    void *grown = realloc(*array, newCapacity * elemSize);
+    if (grown == NULL)
+        return false;
+
+    *array = grown;
+    *capacity = newCapacity;
+    return true;
+}
+
+bool reserveJournal(Journal *j, uint64_t cells, uint64_t members) {
+    if (!j->active)
+        return true;
+
+    return growArray((void **) &j->cells, &j->cellsCapacity,
+                     j->cellsSize + cells, sizeof(cellChange)) &&
+           growArray((void **) &j->members, &j->membersCapacity,
+                     j->membersSize + members, sizeof(memberChange));
+}
+
+void journalCell(gamma_t *g, cell_t elem) {
+    Journal *j = &g->journal;
+    if (!j->active || elem == NO_CELL)
+        return;
+
+    j->cells[j->cellsSize++] =
+            (cellChange) {elem, *nodeAt(&g->board, elem)};
+}
+
+void journalMember(gamma_t *g, uint32_t player) {
+    Journal *j = &g->journal;
+    // empty fields and border have no owner
+    if (!j->active || player == 0 || player > g->players)
+        return;
+
+    Member m = getPlayer(g, player);
+    j->members[j->membersSize++] =
+            (memberChange) {player, m->areas, m->owned,
+                            m->goldenMoves, m->surrounding};
+}
+
+void rollbackJournal(gamma_t *g) {
+    Journal *j = &g->journal;
+
+    while (j->cellsSize > 0) {
+        cellChange *change = &j->cells[--j->cellsSize];
+        *nodeAt(&g->board, change->elem) = change->node;
+    }
+
+    while (j->membersSize > 0) {
+        memberChange *change = &j->members[--j->membersSize];
+        Member m = getPlayer(g, change->id);
+
+        m->areas = change->areas;
+        m->owned = change->owned;
+        m->goldenMoves = change->goldenMoves;
+        m->surrounding = change->surrounding;
+        storeMember(g, change->id);
+    }
+
+    g->available = j->available;
+}
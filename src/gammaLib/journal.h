@@ -0,0 +1,124 @@
+/** @file
+ * Interface of journal of changes made during transaction.
+ *
+ * @author Karol Zagródka <karol.zagrodka@gmail.com>
+ */
+
+#ifndef GAMMA_JOURNAL_H
+#define GAMMA_JOURNAL_H
+
+#include "../findUnionLib/findUnion.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Number of fields remembered by move on empty field.
+ */
+#define JOURNAL_MOVE_CELLS 5
+
+/**
+ * Number of players remembered by move on empty field.
+ */
+#define JOURNAL_MOVE_MEMBERS 5
+
+/**
+ * Number of players remembered by golden move before taking the field.
+ */
+#define JOURNAL_GOLDEN_MEMBERS 6
+
+/**
+ * Game structure.
+ */
+typedef struct gamma gamma_t;
+
+/** @brief Field before change.
+ */
+struct cellChange {
+    cell_t elem;                /**< Index of changed field */
+    Node node;                  /**< Node of field before change */
+};
+
+/**
+ * Field before change.
+ */
+typedef struct cellChange cellChange;
+
+/** @brief Counters of player before change.
+ */
+struct memberChange {
+    uint32_t id;                /**< Player's id */
+    uint32_t areas;             /**< Number of owned areas */
+    uint64_t owned;             /**< Number of owned fields */
+    uint32_t goldenMoves;       /**< Used golden moves */
+    uint64_t surrounding;       /**< Number of empty fields surrounding */
+};
+
+/**
+ * Counters of player before change.
+ */
+typedef struct memberChange memberChange;
+
+/** @brief Changes made since transaction began.
+ *
+ * Fields and players are remembered before every change, so restoring
+ * them from the last to the first one brings back the game from the
+ * beginning of transaction. Memory is kept between transactions.
+ */
+struct journal {
+    cellChange *cells;          /**< Fields before changes */
+    uint64_t cellsSize;         /**< Number of remembered fields */
+    uint64_t cellsCapacity;     /**< Capacity of cells */
+
+    memberChange *members;      /**< Players before changes */
+    uint64_t membersSize;       /**< Number of remembered players */
+    uint64_t membersCapacity;   /**< Capacity of members */
+
+    uint64_t available;         /**< Number of empty fields at beginning */
+    bool active;                /**< If transaction is in progress */
+};
+
+/**
+ * Changes made since transaction began.
+ */
+typedef struct journal Journal;
+
+/** @brief Initializes empty journal.
+ * @param j - journal
+ */
+void initJournal(Journal *j);
+
+/** @brief Frees journal memory.
+ * @param j - journal
+ */
+void freeJournal(Journal *j);
+
+/** @brief Makes sure that journal can remember enough changes.
+ * Does nothing if there is no transaction.
+ * @param j - journal
+ * @param cells - number of fields that will be remembered
+ * @param members - number of players that will be remembered
+ * @return true if journal is big enough else false
+ */
+bool reserveJournal(Journal *j, uint64_t cells, uint64_t members);
+
+/** @brief Remembers field before change.
+ * Space has to be reserved before. Does nothing if there is no transaction.
+ * @param g - current game
+ * @param elem - index of field or NO_CELL
+ */
+void journalCell(gamma_t *g, cell_t elem);
+
+/** @brief Remembers player's counters before change.
+ * Space has to be reserved before. Does nothing if there is no transaction.
+ * @param g - current game
+ * @param player - Member's id or 0
+ */
+void journalMember(gamma_t *g, uint32_t player);
+
+/** @brief Restores game from the beginning of transaction.
+ * Restored counters of players are stored in file of file board as well.
+ * @param g - current game
+ */
+void rollbackJournal(gamma_t *g);
+
+#endif //GAMMA_JOURNAL_H
@@ -13,6 +13,9 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 /** FUNKCJE POMOCNE PRZY DEBUGOWANIU TESTÓW **/
 
@@ -472,6 +475,720 @@ static int golden_possible(void) {
     return PASS;
 }
 
+/* Testuje, czy golden_possible zauważa zmiany obszarów dalekich pól rywala. */
+static int golden_possible_changes(void) {
+    gamma_t *g = gamma_new(5, 3, 2, 1);
+    assert(g != NULL);
+
+    assert(gamma_move(g, 2, 1, 0));
+    assert(gamma_move(g, 2, 1, 1));
+    assert(gamma_move(g, 2, 1, 2));
+    assert(gamma_move(g, 1, 0, 1));
+    assert(!gamma_golden_possible(g, 1));
+    assert(gamma_next_player_id(g, 2) == 1);
+
+    assert(gamma_move(g, 2, 2, 0));
+    assert(gamma_move(g, 2, 2, 1));
+    assert(!gamma_golden_possible(g, 1));
+
+    assert(gamma_move(g, 2, 2, 2));
+    assert(gamma_golden_possible(g, 1));
+    assert(gamma_golden_move(g, 1, 1, 1));
+    assert(!gamma_golden_possible(g, 1));
+
+    gamma_delete(g);
+    return PASS;
+}
+
+/* Testuje, czy golden_move_legal zgadza się z golden_move i nie zmienia gry. */
+static int golden_move_legal(void) {
+    gamma_t *g = gamma_new(5, 3, 3, 1);
+    assert(g != NULL);
+
+    assert(gamma_move(g, 2, 1, 0));
+    assert(gamma_move(g, 2, 1, 1));
+    assert(gamma_move(g, 2, 1, 2));
+    assert(gamma_move(g, 1, 0, 1));
+    assert(gamma_move(g, 3, 4, 2));
+
+    assert(!gamma_golden_move_legal(g, 1, 1, 1));
+    assert(!gamma_golden_move_legal(g, 1, 1, 0));
+    assert(!gamma_golden_move_legal(g, 1, 0, 1));
+    assert(!gamma_golden_move_legal(g, 1, 3, 1));
+    assert(!gamma_golden_move_legal(g, 4, 1, 1));
+    assert(!gamma_golden_move_legal(g, 3, 1, 0));
+    assert(!gamma_golden_move_legal(g, 3, 1, 1));
+
+    assert(gamma_move(g, 2, 2, 0));
+    assert(gamma_move(g, 2, 2, 1));
+    assert(gamma_move(g, 2, 2, 2));
+    assert(gamma_busy_fields(g, 2) == 6);
+    assert(gamma_golden_move_legal(g, 1, 1, 1));
+    assert(gamma_golden_move(g, 1, 1, 1));
+    assert(!gamma_golden_move_legal(g, 1, 1, 0));
+
+    gamma_delete(g);
+    return PASS;
+}
+
+/* Testuje wypisywanie planszy i pól do bufora podanego przez wywołującego. */
+static int board_into(void) {
+    static const char board[] =
+            "      .      .\n"
+            "   3000 100000\n";
+    char buf[sizeof(board)];
+    char field[32];
+
+    gamma_t *g = gamma_new(2, 2, 100000, 2);
+    assert(g != NULL);
+
+    assert(gamma_move(g, 3000, 0, 0));
+    assert(gamma_move(g, 100000, 1, 0));
+    assert(gamma_board_length(g) == sizeof(board) - 1);
+    assert(!gamma_board_into(g, buf, sizeof(board) - 1));
+    assert(gamma_board_into(g, buf, sizeof(board)));
+    assert(strcmp(buf, board) == 0);
+
+    assert(gamma_field_into(g, 0, 0, field));
+    assert(strcmp(field, "   3000") == 0);
+    assert(gamma_field_into(g, 1, 1, field));
+    assert(strcmp(field, "      .") == 0);
+    assert(!gamma_field_into(g, 2, 0, field));
+
+    gamma_delete(g);
+    return PASS;
+}
+
+/* Testuje, czy zapis planszy do pliku zgadza się z gamma_board. */
+static int board_write(void) {
+    gamma_t *g = gamma_new(300, 300, 20, 10);
+    assert(g != NULL);
+
+    for (uint32_t i = 0; i < 5000; ++i)
+        gamma_move(g, i % 20 + 1, (i * 7919) % 300, (i * 104729) % 300);
+
+    char *p = gamma_board(g);
+    assert(p);
+    size_t length = strlen(p);
+
+    FILE *file = tmpfile();
+    assert(file != NULL);
+    assert(gamma_board_write(g, file));
+    assert((size_t) ftell(file) == length);
+    rewind(file);
+
+    char *written = malloc(length);
+    assert(written != NULL);
+    assert(fread(written, 1, length, file) == length);
+    assert(memcmp(written, p, length) == 0);
+
+    free(written);
+    free(p);
+    fclose(file);
+    gamma_delete(g);
+    return PASS;
+}
+
+/* Testuje, czy ruchy wykonane naraz dają te same wyniki co po kolei. */
+static int move_batch(void) {
+    static const uint32_t moves_count = 3000;
+    move_t *moves = malloc(moves_count * sizeof(move_t));
+    bool *results = malloc(moves_count * sizeof(bool));
+    assert(moves != NULL && results != NULL);
+
+    gamma_t *g = gamma_new(40, 30, 7, 5);
+    gamma_t *h = gamma_new(40, 30, 7, 5);
+    assert(g != NULL && h != NULL);
+
+    for (uint32_t i = 0; i < moves_count; ++i)
+        moves[i] = (move_t) {(i * 13) % 9, (i * 7919) % 42, (i * 104729) % 31};
+
+    size_t made = gamma_move_batch(g, moves, moves_count / 2, results);
+    for (uint32_t i = 0; i < moves_count / 2; ++i) {
+        assert(results[i] ==
+               gamma_move(h, moves[i].player, moves[i].x, moves[i].y));
+        made -= results[i];
+    }
+    assert(made == 0);
+
+    made = gamma_golden_move_batch(g, moves + moves_count / 2,
+                                   moves_count / 2, results);
+    for (uint32_t i = 0; i < moves_count / 2; ++i) {
+        move_t *m = &moves[moves_count / 2 + i];
+        assert(results[i] == gamma_golden_move(h, m->player, m->x, m->y));
+        made -= results[i];
+    }
+    assert(made == 0);
+
+    char *p = gamma_board(g);
+    char *q = gamma_board(h);
+    assert(p != NULL && q != NULL);
+    assert(strcmp(p, q) == 0);
+
+    assert(gamma_move_batch(NULL, moves, moves_count, NULL) == 0);
+
+    free(p);
+    free(q);
+    free(moves);
+    free(results);
+    gamma_delete(g);
+    gamma_delete(h);
+    return PASS;
+}
+
+/* Porównuje stan dwóch gier o tych samych parametrach. */
+static bool same_games(gamma_t *g, gamma_t *h, uint32_t players) {
+    char *p = gamma_board(g);
+    char *q = gamma_board(h);
+    bool output = p != NULL && q != NULL && strcmp(p, q) == 0;
+
+    for (uint32_t player = 1; player <= players; ++player)
+        output = output &&
+                 gamma_busy_fields(g, player) == gamma_busy_fields(h, player) &&
+                 gamma_free_fields(g, player) == gamma_free_fields(h, player) &&
+                 gamma_golden_possible(g, player) ==
+                 gamma_golden_possible(h, player);
+
+    free(p);
+    free(q);
+    return output;
+}
+
+/* Porównuje planszę i pola graczy, ale nie złote ruchy. */
+static bool same_fields(gamma_t *g, gamma_t *h, uint32_t players) {
+    char *p = gamma_board(g);
+    char *q = gamma_board(h);
+    bool output = p != NULL && q != NULL && strcmp(p, q) == 0;
+
+    for (uint32_t player = 1; player <= players; ++player)
+        output = output &&
+                 gamma_busy_fields(g, player) == gamma_busy_fields(h, player) &&
+                 gamma_free_fields(g, player) == gamma_free_fields(h, player);
+
+    free(p);
+    free(q);
+    return output;
+}
+
+/* Testuje złoty ruch dzielący obszar na części różnej wielkości. */
+static int golden_split(void) {
+    gamma_t *g = gamma_new(10, 5, 2, 4);
+    gamma_t *h = gamma_new(10, 5, 2, 4);
+    assert(g != NULL && h != NULL);
+
+    // krzyż gracza 1 o ramionach długości 3, 6, 2 i 2
+    for (uint32_t x = 0; x < 10; ++x) {
+        assert(gamma_move(g, 1, x, 2));
+        assert(x == 3 || gamma_move(h, 1, x, 2));
+    }
+    for (uint32_t y = 0; y < 5; ++y) {
+        assert(y == 2 || gamma_move(g, 1, 3, y));
+        assert(y == 2 || gamma_move(h, 1, 3, y));
+    }
+    assert(gamma_move(h, 2, 3, 2));
+
+    assert(gamma_golden_move(g, 2, 3, 2));
+    assert(same_fields(g, h, 2));
+    assert(gamma_busy_fields(g, 1) == 13);
+    assert(!gamma_move(g, 1, 0, 0));
+
+    // łączenie części i kolejne podziały działają jak w grze bez złotego ruchu
+    for (uint32_t i = 0; i < 200; ++i) {
+        uint32_t player = i % 2 + 1;
+        uint32_t x = (i * 7) % 10;
+        uint32_t y = (i * 3) % 5;
+        assert(gamma_move(g, player, x, y) == gamma_move(h, player, x, y));
+    }
+    assert(same_fields(g, h, 2));
+
+    gamma_delete(g);
+    gamma_delete(h);
+    return PASS;
+}
+
+/* Wykonuje ruch lub złoty ruch zależnie od numeru ruchu. */
+static bool transaction_move(gamma_t *g, uint32_t i) {
+    uint32_t player = (i * 13) % 5 + 1;
+    uint32_t x = (i * 7919) % 12;
+    uint32_t y = (i * 104729) % 9;
+
+    if (i % 7 == 0)
+        return gamma_golden_move(g, player, x, y);
+    else
+        return gamma_move(g, player, x, y);
+}
+
+/* Testuje, czy rollback przywraca grę sprzed begin,
+ * a commit zachowuje ruchy. */
+static int transaction(void) {
+    gamma_t *g = gamma_new(12, 9, 5, 3);
+    gamma_t *h = gamma_new(12, 9, 5, 3);
+    assert(g != NULL && h != NULL);
+
+    assert(!gamma_begin(NULL));
+    assert(!gamma_rollback(g));
+    assert(!gamma_commit(g));
+
+    uint32_t i = 0;
+    for (uint32_t round = 0; round < 40; ++round) {
+        assert(gamma_begin(g));
+        assert(!gamma_begin(g));
+        for (uint32_t j = 0; j < 60; ++j)
+            transaction_move(g, i + j * 31);
+        gamma_golden_possible(g, round % 5 + 1);
+        assert(gamma_rollback(g));
+        assert(same_games(g, h, 5));
+
+        assert(gamma_begin(g));
+        for (uint32_t j = 0; j < 5; ++j, ++i)
+            assert(transaction_move(g, i) == transaction_move(h, i));
+        assert(gamma_commit(g));
+        assert(same_games(g, h, 5));
+    }
+
+    gamma_delete(g);
+    gamma_delete(h);
+    return PASS;
+}
+
+/* Testuje, czy kopia gry jest taka sama jak gra i niezależna od niej. */
+static int clone(void) {
+    gamma_t *g = gamma_new(12, 9, 5, 3);
+    assert(g != NULL);
+    assert(gamma_clone(NULL) == NULL);
+
+    for (uint32_t i = 0; i < 100; ++i)
+        transaction_move(g, i);
+    gamma_golden_possible(g, 1);
+
+    gamma_t *c = gamma_clone(g);
+    assert(c != NULL);
+    assert(same_games(g, c, 5));
+
+    for (uint32_t i = 100; i < 200; ++i)
+        assert(transaction_move(g, i) == transaction_move(c, i));
+    assert(same_games(g, c, 5));
+
+    char *before = gamma_board(g);
+    assert(before != NULL);
+    for (uint32_t i = 200; i < 300; ++i)
+        transaction_move(c, i);
+    char *after = gamma_board(g);
+    assert(after != NULL);
+    assert(strcmp(before, after) == 0);
+    gamma_delete(c);
+
+    assert(gamma_begin(g));
+    for (uint32_t i = 300; i < 400; ++i)
+        transaction_move(g, i);
+    c = gamma_clone(g);
+    assert(c != NULL);
+    assert(!gamma_rollback(c));
+    assert(gamma_commit(g));
+    assert(same_games(g, c, 5));
+
+    free(before);
+    free(after);
+    gamma_delete(c);
+    gamma_delete(g);
+    return PASS;
+}
+
+/* Testuje zapis gry do pliku i jej odczyt. */
+static int save_load(void) {
+    gamma_t *g = gamma_new(12, 9, 5, 3);
+    assert(g != NULL);
+
+    for (uint32_t i = 0; i < 150; ++i)
+        transaction_move(g, i);
+
+    FILE *file = tmpfile();
+    assert(file != NULL);
+    assert(!gamma_save(NULL, file));
+    assert(gamma_save(g, file));
+
+    rewind(file);
+    gamma_t *h = gamma_load(file);
+    assert(h != NULL);
+    assert(same_games(g, h, 5));
+
+    for (uint32_t i = 150; i < 300; ++i)
+        assert(transaction_move(g, i) == transaction_move(h, i));
+    assert(same_games(g, h, 5));
+    gamma_delete(h);
+
+    // licznik pustych pól wokół gracza 1 nie zgadza się z planszą,
+    // zapisany za nagłówkiem (64 bajty), id, obszarami i polami gracza
+    uint64_t surrounding = 1234567;
+    fseek(file, 64 + 16, SEEK_SET);
+    assert(fwrite(&surrounding, sizeof(surrounding), 1, file) == 1);
+    rewind(file);
+    assert(gamma_load(file) == NULL);
+
+    rewind(file);
+    assert(gamma_save(g, file));
+
+    // właściciel ostatniego pola nie jest graczem
+    fseek(file, -8, SEEK_END);
+    fputc(6, file);
+    rewind(file);
+    assert(gamma_load(file) == NULL);
+
+    fclose(file);
+    gamma_delete(g);
+    return PASS;
+}
+
+/* Zapisuje i wczytuje grę, która na nowo zbiera kandydatów złotych ruchów. */
+static gamma_t *reload(gamma_t *g) {
+    FILE *file = tmpfile();
+    assert(file != NULL);
+    assert(gamma_save(g, file));
+
+    rewind(file);
+    gamma_t *h = gamma_load(file);
+    fclose(file);
+    return h;
+}
+
+/* Testuje porządkowanie i zwalnianie kandydatów złotych ruchów. */
+static int candidates(void) {
+    gamma_t *g = gamma_new(200, 200, 5, 1);
+    assert(g != NULL);
+
+    // pasy graczy stykają się, więc listy kandydatów są porządkowane
+    for (uint32_t i = 0; i < 200 * 200; ++i) {
+        assert(gamma_move(g, (i % 200) / 40 + 1, i % 200, i / 200));
+
+        if (i % 8000 == 7999) {
+            gamma_t *h = reload(g);
+            assert(h != NULL);
+            assert(same_games(g, h, 5));
+            gamma_delete(h);
+        }
+    }
+
+    // gracz po wycofanym ostatnim złotym ruchu nie ma już listy
+    gamma_t *h = reload(g);
+    assert(h != NULL);
+    for (uint32_t player = 1; player <= 5; ++player) {
+        uint32_t x = player < 5 ? 40 * player : 159;
+        assert(gamma_begin(g));
+        assert(gamma_golden_move(g, player, x, 100));
+        assert(!gamma_golden_possible(g, player));
+        assert(gamma_rollback(g));
+    }
+    assert(same_games(g, h, 5));
+
+    for (uint32_t player = 1; player <= 5; ++player) {
+        uint32_t x = player < 5 ? 40 * player : 159;
+        assert(gamma_golden_move(g, player, x, player));
+        assert(gamma_golden_move(h, player, x, player));
+    }
+    assert(same_games(g, h, 5));
+
+    gamma_delete(h);
+    gamma_delete(g);
+    return PASS;
+}
+
+/* Testuje tworzenie gry z planszy właścicieli pól. */
+static int import(void) {
+    static const uint32_t width = 30, height = 20;
+    uint32_t owners[30 * 20];
+
+    gamma_t *g = gamma_new(width, height, 5, width * height);
+    assert(g != NULL);
+
+    for (uint32_t y = 0; y < height; ++y)
+        for (uint32_t x = 0; x < width; ++x) {
+            owners[y * width + x] = (x / 3 + y / 2 + x * y) % 6;
+            if (owners[y * width + x] != 0)
+                assert(gamma_move(g, owners[y * width + x], x, y));
+        }
+
+    gamma_t *h = gamma_import(width, height, 5, width * height, owners);
+    assert(h != NULL);
+    assert(same_games(g, h, 5));
+
+    for (uint32_t i = 0; i < 300; ++i)
+        assert(transaction_move(g, i) == transaction_move(h, i));
+    assert(same_games(g, h, 5));
+
+    assert(gamma_import(width, height, 5, 1, owners) == NULL);
+    assert(gamma_import(width, height, 5, width * height, NULL) == NULL);
+    owners[width * height - 1] = 6;
+    assert(gamma_import(width, height, 5, width * height, owners) == NULL);
+
+    gamma_delete(g);
+    gamma_delete(h);
+    return PASS;
+}
+
+/* Testuje tworzenie gry z planszy wypisanej przez gamma_board. */
+static int board_text(void) {
+    uint32_t golden_used[12] = {0};
+
+    gamma_t *g = gamma_new(12, 9, 12, 3);
+    assert(g != NULL);
+
+    for (uint32_t i = 0; i < 400; ++i) {
+        uint32_t player = (i * 13) % 12 + 1;
+        uint32_t x = (i * 7919) % 12;
+        uint32_t y = (i * 104729) % 9;
+
+        if (i % 7 == 0 && gamma_golden_move(g, player, x, y))
+            golden_used[player - 1]++;
+        else if (i % 7 != 0)
+            gamma_move(g, player, x, y);
+    }
+
+    char *text = gamma_board(g);
+    assert(text != NULL);
+
+    gamma_t *h = gamma_from_board_text(text, 12, 3, golden_used);
+    assert(h != NULL);
+    assert(same_games(g, h, 12));
+
+    for (uint32_t i = 400; i < 700; ++i)
+        assert(transaction_move(g, i) == transaction_move(h, i));
+    assert(same_games(g, h, 12));
+
+    assert(gamma_from_board_text(text, 9, 3, NULL) == NULL);
+    assert(gamma_from_board_text("", 12, 3, NULL) == NULL);
+    text[strlen(text) - 1] = ' ';
+    assert(gamma_from_board_text(text, 12, 3, NULL) == NULL);
+    text[1] = 'x';
+    text[strlen(text) - 1] = '\n';
+    assert(gamma_from_board_text(text, 12, 3, NULL) == NULL);
+
+    free(text);
+    gamma_delete(g);
+    gamma_delete(h);
+    return PASS;
+}
+
+/* Testuje grę na rzadkiej planszy. */
+static int sparse_board(void) {
+    gamma_t *g = gamma_new_sparse(700, 5, 5, 3);
+    gamma_t *h = gamma_new(700, 5, 5, 3);
+    assert(g != NULL && h != NULL);
+
+    for (uint32_t i = 0; i < 3000; ++i) {
+        uint32_t player = (i * 13) % 5 + 1;
+        uint32_t x = (i * 7919) % 700;
+        uint32_t y = (i * 104729) % 5;
+
+        if (i % 7 == 0)
+            assert(gamma_golden_move(g, player, x, y) ==
+                   gamma_golden_move(h, player, x, y));
+        else
+            assert(gamma_move(g, player, x, y) == gamma_move(h, player, x, y));
+    }
+    assert(same_games(g, h, 5));
+
+    gamma_t *c = gamma_clone(g);
+    assert(c != NULL);
+    assert(same_games(c, h, 5));
+    gamma_delete(c);
+
+    FILE *file = tmpfile();
+    assert(file != NULL);
+    assert(!gamma_save(g, file));
+    fclose(file);
+
+    gamma_delete(g);
+    gamma_delete(h);
+
+    // plansza z bilionem pól jest rzadka
+    g = gamma_new(1000000, 1000000, 2, 1000);
+    assert(g != NULL);
+    for (uint32_t i = 0; i < 1000; ++i)
+        assert(gamma_move(g, i % 2 + 1, i * 999, i * 997));
+    assert(gamma_busy_fields(g, 1) == 500);
+    assert(gamma_free_fields(g, 2) == 1000000ULL * 1000000ULL - 1000);
+    assert(gamma_golden_move(g, 1, 999, 997));
+    assert(gamma_golden_possible(g, 2));
+    gamma_delete(g);
+    return PASS;
+}
+
+/* Testuje planszę, której pola mają numery większe od UINT32_MAX. */
+static int huge_board(void) {
+    gamma_t *g = gamma_new(1 << 16, (1 << 16) + 1, 2, 2);
+    assert(g != NULL);
+    assert(gamma_free_fields(g, 1) == (1ULL << 32) + (1 << 16));
+
+    // pole (0, 2^16) ma numer 2^32
+    assert(gamma_move(g, 1, 0, 0));
+    assert(gamma_move(g, 2, 0, 1 << 16));
+    assert(gamma_move(g, 2, 1, 1 << 16));
+    assert(gamma_busy_fields(g, 1) == 1);
+    assert(gamma_busy_fields(g, 2) == 2);
+    assert(gamma_free_fields(g, 1) == (1ULL << 32) + (1 << 16) - 3);
+    assert(gamma_golden_move(g, 1, 1, 1 << 16));
+    assert(gamma_free_fields(g, 1) == 4);
+
+    gamma_delete(g);
+    return PASS;
+}
+
+/* Testuje, czy utworzenie dużej planszy nie zajmuje jej pamięci. */
+static int lazy_board(void) {
+    struct rusage before, after;
+    assert(getrusage(RUSAGE_SELF, &before) == 0);
+
+    // plansza ma prawie 80 GB, zapisane są tylko strony wokół ruchów
+    gamma_t *g = gamma_new(70000, 70000, 2, 5);
+    assert(g != NULL);
+    assert(gamma_move(g, 1, 0, 0));
+    assert(gamma_move(g, 1, 69999, 0));
+    assert(gamma_move(g, 2, 0, 69999));
+    assert(gamma_move(g, 2, 69999, 69999));
+    assert(gamma_free_fields(g, 1) == 70000ULL * 70000 - 4);
+
+    // kopia też ma tylko strony wokół ruchów
+    gamma_t *c = gamma_clone(g);
+    assert(c != NULL);
+    assert(gamma_move(c, 1, 1, 0));
+    assert(gamma_busy_fields(c, 1) == 3);
+    assert(gamma_busy_fields(g, 1) == 2);
+    assert(gamma_golden_possible(c, 2));
+
+    assert(getrusage(RUSAGE_SELF, &after) == 0);
+    assert(after.ru_maxrss - before.ru_maxrss < 16 * 1024);
+
+    gamma_delete(c);
+    gamma_delete(g);
+    return PASS;
+}
+
+/* Wykonuje ruch lub złoty ruch na planszy 70 na 40. */
+static bool mapped_move(gamma_t *g, uint32_t i) {
+    uint32_t player = (i * 13) % 5 + 1;
+    uint32_t x = (i * 7919) % 70;
+    uint32_t y = (i * 104729) % 40;
+
+    if (i % 7 == 0)
+        return gamma_golden_move(g, player, x, y);
+    else
+        return gamma_move(g, player, x, y);
+}
+
+/* Testuje grę z planszą trzymaną w pliku. */
+static int mapped_board(void) {
+    static const char path[] = "gamma_test_mapped.tmp";
+
+    gamma_t *g = gamma_new_mapped(70, 40, 5, 3, path);
+    gamma_t *h = gamma_new(70, 40, 5, 3);
+    assert(g != NULL && h != NULL);
+    assert(!gamma_sync(h));
+
+    for (uint32_t i = 0; i < 2000; ++i)
+        assert(mapped_move(g, i) == mapped_move(h, i));
+    assert(same_games(g, h, 5));
+
+    // kopia planszy z pliku jest trzymana w pamięci
+    gamma_t *c = gamma_clone(g);
+    gamma_t *d = gamma_clone(h);
+    assert(c != NULL && d != NULL);
+    assert(same_games(c, h, 5));
+    for (uint32_t i = 3000; i < 4000; ++i)
+        assert(mapped_move(c, i) == mapped_move(d, i));
+    assert(same_games(c, d, 5));
+    gamma_delete(c);
+    gamma_delete(d);
+
+    assert(gamma_sync(g));
+    gamma_delete(g);
+
+    g = gamma_open_mapped(path);
+    assert(g != NULL);
+    assert(same_games(g, h, 5));
+
+    for (uint32_t i = 2000; i < 3000; ++i)
+        assert(mapped_move(g, i) == mapped_move(h, i));
+    assert(same_games(g, h, 5));
+    assert(gamma_begin(g));
+    assert(!gamma_sync(g));
+    assert(gamma_rollback(g));
+    assert(gamma_sync(g));
+    gamma_delete(g);
+
+    // ruchy po ostatnim zapisie zostają w pliku, niezatwierdzone znikają
+    g = gamma_open_mapped(path);
+    assert(g != NULL);
+    assert(same_games(g, h, 5));
+    for (uint32_t i = 3000; i < 3500; ++i)
+        assert(mapped_move(g, i) == mapped_move(h, i));
+    assert(gamma_begin(g));
+    for (uint32_t i = 4000; i < 4100; ++i)
+        mapped_move(g, i);
+    gamma_delete(g);
+
+    g = gamma_open_mapped(path);
+    assert(g != NULL);
+    assert(same_games(g, h, 5));
+    gamma_delete(g);
+    gamma_delete(h);
+
+    // proces kończy się bez gamma_sync() i bez usunięcia gry
+    g = gamma_new_mapped(70, 40, 5, 3, path);
+    h = gamma_new(70, 40, 5, 3);
+    assert(g != NULL && h != NULL);
+    gamma_delete(g);
+
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        g = gamma_open_mapped(path);
+        bool moved = g != NULL && gamma_move(g, 1, 0, 0) &&
+                     gamma_move(g, 2, 1, 0);
+        for (uint32_t i = 0; moved && i < 1000; ++i)
+            if (i % 7 != 0)
+                mapped_move(g, i);
+
+        // wycofany złoty ruch znów jest dostępny w pliku
+        moved = moved && gamma_begin(g) && gamma_golden_move(g, 1, 1, 0) &&
+                gamma_rollback(g);
+        _exit(moved ? 0 : 1);
+    }
+
+    int status;
+    assert(waitpid(pid, &status, 0) == pid);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(gamma_move(h, 1, 0, 0) && gamma_move(h, 2, 1, 0));
+    for (uint32_t i = 0; i < 1000; ++i)
+        if (i % 7 != 0)
+            mapped_move(h, i);
+
+    g = gamma_open_mapped(path);
+    assert(g != NULL);
+    assert(same_games(g, h, 5));
+    gamma_delete(g);
+    gamma_delete(h);
+
+    // złoty ruch przy brzegu kopii zmienia pola wokół gracza 1 tak samo
+    g = gamma_new_mapped(3, 3, 2, 1, path);
+    h = gamma_new(3, 3, 2, 1);
+    assert(g != NULL && h != NULL);
+    assert(gamma_move(g, 1, 0, 1) && gamma_move(h, 1, 0, 1));
+    assert(gamma_move(g, 1, 0, 2) && gamma_move(h, 1, 0, 2));
+    assert(gamma_move(g, 2, 1, 2) && gamma_move(h, 2, 1, 2));
+    c = gamma_clone(g);
+    assert(c != NULL);
+    assert(gamma_golden_move(c, 2, 0, 2) && gamma_golden_move(h, 2, 0, 2));
+    assert(same_games(c, h, 2));
+    assert(gamma_free_fields(c, 1) == 2);
+    gamma_delete(c);
+    gamma_delete(g);
+
+    remove(path);
+    assert(gamma_open_mapped(path) == NULL);
+    gamma_delete(h);
+    return PASS;
+}
+
 /* Testuje liczenie obszarów jednego gracza. */
 static int areas(void) {
     gamma_t *g = gamma_new(31, 37, 1, 42);
@@ -783,6 +1500,22 @@ static const test_list_t test_list[] = {
         TEST(normal_move),
         TEST(golden_move),
         TEST(golden_possible),
+        TEST(golden_possible_changes),
+        TEST(golden_move_legal),
+        TEST(board_into),
+        TEST(board_write),
+        TEST(move_batch),
+        TEST(golden_split),
+        TEST(transaction),
+        TEST(clone),
+        TEST(save_load),
+        TEST(candidates),
+        TEST(import),
+        TEST(board_text),
+        TEST(sparse_board),
+        TEST(huge_board),
+        TEST(mapped_board),
+        TEST(lazy_board),
         TEST(areas),
         TEST(tree),
         TEST(border),
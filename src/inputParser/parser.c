@@ -4,11 +4,12 @@
  * @author Karol Zagródka <karol.zagrodka@gmail.com>
  */
 
-/** Enables getline */
+/** Enables POSIX functions used to read input */
 #define _XOPEN_SOURCE 700
 
 #include "parser.h"
 #include "../gameMode/batchMode.h"
+#include "../gameMode/binaryMode.h"
 #include "../gameMode/interactiveMode.h"
 
 #include <stdlib.h>
@@ -16,13 +17,66 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdint.h>
-#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Environment variable that turns on buffered output.
+ */
+#define BUFFERED_OUTPUT_ENV "GAMMA_BUFFERED_OUTPUT"
+
+/**
+ * Size of standard output buffer in buffered mode.
+ */
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+
+/**
+ * Number of bytes read from standard input at once.
+ */
+#define INPUT_BLOCK_SIZE (1 << 16)
 
 /**
  * Line number counter.
  */
 int lineNumber = 0;
 
+/**
+ * If standard output is flushed only when buffer is full.
+ */
+static bool bufferedOutput = false;
+
+/**
+ * Read part of standard input, reused for every line.
+ */
+static char *input = NULL;
+
+/**
+ * Capacity of input.
+ */
+static size_t inputCapacity = 0;
+
+/**
+ * Position of first char of input that wasn't given yet.
+ */
+static size_t inputBegin = 0;
+
+/**
+ * Number of chars in input.
+ */
+static size_t inputEnd = 0;
+
+/**
+ * If there is nothing more to read from standard input.
+ */
+static bool inputEnded = false;
+
+/**
+ * If input is the whole standard input mapped to memory.
+ */
+static bool inputMapped = false;
+
 /** @brief Check if number is correct.
  * Check if @p num fits in uint32_t
  * @param num - checked number
@@ -30,6 +84,33 @@ int lineNumber = 0;
  */
 static bool correctNumber(uint64_t num);
 
+/** @brief Check if char is whitespace.
+ * Same as isspace() in "C" locale.
+ * @param ch - checked char
+ * @return true if @p ch is whitespace else false
+ */
+static bool isSpace(char ch);
+
+/** @brief Check if char is decimal digit.
+ * @param ch - checked char
+ * @return true if @p ch is digit else false
+ */
+static bool isDigit(char ch);
+
+/** @brief Reads next block of standard input.
+ * Moves chars that weren't given yet to the beginning of input and
+ * fills the rest of it, growing input if it is full.
+ * @return false if nothing was read else true
+ */
+static bool readBlock();
+
+/** @brief Maps standard input to memory.
+ * If standard input is a regular file, the whole file becomes input,
+ * so lines are given straight from the mapping without reading them.
+ * Otherwise does nothing.
+ */
+static void mapInput();
+
 /** @brief Tries to chose and launch game mode.
  * Read single line by giveLine and tries to play game.
  * @return true if game was played or EOF else false
@@ -40,39 +121,78 @@ static inline bool correctNumber(uint64_t num) {
     return num <= UINT32_MAX;
 }
 
+static inline bool isSpace(char ch) {
+    return ch == ' ' || (ch >= '\t' && ch <= '\r');
+}
+
+static inline bool isDigit(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+static bool readBlock() {
+    size_t left = inputEnd - inputBegin;
+    if (left > 0)
+        memmove(input, input + inputBegin, left);
+    inputBegin = 0;
+    inputEnd = left;
+
+    if (inputCapacity - inputEnd < INPUT_BLOCK_SIZE) {
+        size_t capacity = inputCapacity == 0 ?
+                          INPUT_BLOCK_SIZE : 2 * inputCapacity;
+        char *grown = realloc(input, capacity);
+        if (grown == NULL)
+            return false;
+
+        input = grown;
+        inputCapacity = capacity;
+    }
+
+    // unlike fread() it doesn't wait for the whole block from terminal
+    ssize_t bytes;
+    do {
+        bytes = read(STDIN_FILENO, input + inputEnd, inputCapacity - inputEnd);
+    } while (bytes < 0 && errno == EINTR);
+
+    if (bytes <= 0)
+        return false;
+
+    inputEnd += bytes;
+    return true;
+}
+
 static bool gameSuccess() {
 
-    char *instructions;
+    char *instructions, *end;
     uint32_t values[4];
 
-    if (!giveLine(&instructions))
+    if (!giveLine(&instructions, &end))
         return true;
 
+    char command = instructions == end ? '\0' : instructions[0];
+
     // comment or new line
-    if (instructions[0] == '#' || instructions[0] == '\n') {
-        free(instructions);
+    if (command == '#' || command == '\n')
         return false;
-    }
 
-    if ((instructions[0] == 'B' || instructions[0] == 'I')
-        && readNumbers(values, instructions + 1, 4)) {
-        if (instructions[0] == 'B') {
+    if ((command == 'B' || command == 'I' || command == 'R')
+        && readNumbers(values, instructions + 1, end, 4)) {
+        if (command == 'B') {
             // batch mode with values
-            if (initializeBatch(values)) {
-                free(instructions);
+            if (initializeBatch(values))
+                return true; // game completed
+        }
+        else if (command == 'R') {
+            // binary mode with values
+            if (initializeBinary(values))
                 return true; // game completed
-            }
         }
         else {
             // interactive mode with values
-            if (initializeInteractive(values)) {
-                free(instructions);
+            if (initializeInteractive(values))
                 return true; // game completed
-            }
         }
     }
 
-    free(instructions);
     errorMessage();
     return false;
 }
@@ -92,65 +212,158 @@ inline void okMessage() {
     fflush(stdout);
 }
 
+bool isOutputBuffered() {
+    return bufferedOutput;
+}
+
 inline void errorMessage() {
     fprintf(stderr, "ERROR %d\n", lineNumber);
 }
 
-bool readNumbers(uint32_t values[], char *str, int expectingValues) {
-    uint64_t result;
-    char *endPtr;
+static void mapInput() {
+    struct stat info;
+    if (fstat(STDIN_FILENO, &info) != 0 || !S_ISREG(info.st_mode))
+        return;
 
-    if (strlen(str) == 0 || isspace(str[0]) == 0) // no free space
-        return false;
+    // file may be already partly read
+    off_t position = lseek(STDIN_FILENO, 0, SEEK_CUR);
+    if (position < 0 || info.st_size <= position ||
+        (uint64_t) info.st_size > SIZE_MAX)
+        return;
 
+    void *map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE,
+                     STDIN_FILENO, 0);
+    if (map == MAP_FAILED)
+        return;
 
-    for (int num = 0; num < expectingValues; num++) {
+    posix_madvise(map, info.st_size, POSIX_MADV_SEQUENTIAL);
 
-        uint64_t shift = 0;
-        // not a number
-        while((str[shift] < '0' || str[shift] > '9')) {
-            // not a whitespace
-            if (isspace(str[shift]) == 0) {
-                return false;
-            }
-            shift++;
-        }
-        str += shift;
+    input = map;
+    inputCapacity = info.st_size;
+    inputBegin = position;
+    inputEnd = info.st_size;
+    inputEnded = true;
+    inputMapped = true;
+}
 
-        result = strtoul(str, &endPtr, 10);
+int readNumber(uint32_t *value, const char **str, const char *end) {
+    const char *current = *str;
 
-        if (!correctNumber(result) || str == endPtr)
-            return false;
+    while (current != end && isSpace(*current))
+        current++;
 
-        str = endPtr;
-        values[num] = result;
+    if (current == end) {
+        *str = current;
+        return 0;
     }
 
-    // anything different than whitespaces on the end of the line
-    if (strtok(str, " \t\v\f\r\n") != NULL)
+    // not a number
+    if (!isDigit(*current))
+        return -1;
+
+    uint64_t result = 0;
+    while (current != end && isDigit(*current)) {
+        result = 10 * result + (uint64_t) (*current - '0');
+        if (!correctNumber(result))
+            return -1;
+        current++;
+    }
+
+    *value = result;
+    *str = current;
+    return 1;
+}
+
+int64_t countNumbers(const char *str, const char *end) {
+    uint32_t value;
+    int64_t output = 0;
+    int read;
+
+    if (str == end || !isSpace(*str)) // no free space
+        return -1;
+
+    while ((read = readNumber(&value, &str, end)) == 1)
+        output++;
+
+    return read == 0 ? output : -1;
+}
+
+bool readNumbers(uint32_t values[], const char *str, const char *end,
+                 int expectingValues) {
+    if (str == end || !isSpace(*str)) // no free space
         return false;
 
-    return true;
+    for (int num = 0; num < expectingValues; num++)
+        if (readNumber(&values[num], &str, end) != 1)
+            return false;
+
+    // anything different than whitespaces on the end of the line
+    return readNumber(&values[0], &str, end) == 0;
 }
 
-bool giveLine(char **str) {
+bool giveLine(char **str, char **end) {
     lineNumber++;
-    size_t inputSize = 0;
-    char *instructions = NULL;
-
-    ssize_t read = getline(&instructions, &inputSize, stdin);
+    size_t scanned = inputBegin;
+    char *newLine;
+
+    while (true) {
+        newLine = scanned == inputEnd ? NULL :
+                  memchr(input + scanned, '\n', inputEnd - scanned);
+        if (newLine != NULL || inputEnded)
+            break;
+
+        // chars before scanned are moved to the beginning of input
+        scanned = inputEnd - inputBegin;
+        inputEnded = !readBlock();
+    }
 
-    if (read == -1) {
-        free(instructions);
+    if (newLine == NULL && inputBegin == inputEnd)
         return false;
+
+    char *line = input + inputBegin;
+    char *lineEnd = newLine == NULL ? input + inputEnd : newLine + 1;
+    inputBegin = lineEnd - input;
+
+    // line is seen only up to first '\0'
+    char *zero = memchr(line, '\0', lineEnd - line);
+
+    *str = line;
+    *end = zero == NULL ? lineEnd : zero;
+    return true;
+}
+
+bool giveBytes(char **str, size_t size) {
+    while (inputEnd - inputBegin < size) {
+        if (inputEnded)
+            return false;
+
+        inputEnded = !readBlock();
     }
 
-    *str = instructions;
+    *str = input + inputBegin;
+    inputBegin += size;
     return true;
 }
 
+size_t bufferedBytes() {
+    return inputEnd - inputBegin;
+}
+
 void playGame() {
+    // buffer has to be set before anything is written
+    if (getenv(BUFFERED_OUTPUT_ENV) != NULL &&
+        setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER_SIZE) == 0)
+        bufferedOutput = true;
+
+    mapInput();
+
     while (!gameSuccess()) {
         fflush(stdout);
     }
+
+    if (inputMapped)
+        munmap(input, inputCapacity);
+    else
+        free(input);
+    input = NULL;
 }
@@ -7,6 +7,7 @@
 #ifndef GAMMA_PARSER_H
 #define GAMMA_PARSER_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -21,27 +22,70 @@ void textMessage(char *str);
  */
 void okMessage();
 
+/** @brief Check if output is buffered.
+ * Output is buffered if environment variable GAMMA_BUFFERED_OUTPUT is set,
+ * then batch mode doesn't flush it after every command.
+ * @return true if output is buffered else false
+ */
+bool isOutputBuffered();
+
 /** @brief Prints error message.
  * Prints ERROR with line number
  */
 void errorMessage();
 
+/** @brief Reads next number of line.
+ * Skips whitespaces before number and moves @p str after it.
+ * @param value - read number
+ * @param str - pointer to first char to read
+ * @param end - char after the last one
+ * @return 1 if number was read, 0 if there were only whitespaces left,
+ * -1 if there was something else or number didn't fit in uint32_t
+ */
+int readNumber(uint32_t *value, const char **str, const char *end);
+
+/** @brief Counts numbers in line.
+ * @param str - first char after command
+ * @param end - char after the last one
+ * @return number of numbers if line starts with whitespace and has only
+ * whitespaces and numbers that fit in uint32_t else -1
+ */
+int64_t countNumbers(const char *str, const char *end);
+
 /** @brief Extract number from @p str.
- * Extract @p expectingValues numbers from @p str and store it in @p values
+ * Extract @p expectingValues numbers from chars from @p str to @p end
+ * and store it in @p values
  * @param values - Array where read numbers will be stored
- * @param str - string with numbers
+ * @param str - first char with numbers
+ * @param end - char after the last one
  * @param expectingValues - number of numbers to be read
  * @return true if exactly @p expectingValues numbers were read and the string
  * contains only whitespaces else false
  */
-bool readNumbers(uint32_t values[], char *str, int expectingValues);
+bool readNumbers(uint32_t values[], const char *str, const char *end,
+                 int expectingValues);
 
 /** @brief Reads line from standard input.
- * Reads line and save it to @p str
- * @param str - read line
+ * Gives line from @p str to @p end, with '\n' if there was one. Line ends
+ * before its first '\0'. Line stays valid until next call.
+ * @param str - first char of read line
+ * @param end - char after the last one
  * @return false if EOF else true
  */
-bool giveLine(char **str);
+bool giveLine(char **str, char **end);
+
+/** @brief Reads bytes from standard input.
+ * Gives next @p size bytes of input, that stay valid until next read.
+ * @param str - first of read bytes
+ * @param size - number of bytes to read
+ * @return false if there are less than @p size bytes left else true
+ */
+bool giveBytes(char **str, size_t size);
+
+/** @brief Number of bytes read but not given yet.
+ * @return number of bytes that can be given without reading
+ */
+size_t bufferedBytes();
 
 /** @brief Plays gamma game.
  */
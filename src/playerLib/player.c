@@ -5,17 +5,105 @@
  */
 
 #include "player.h"
+#include <string.h>
 
 
-Member newMember(uint32_t id) {
-    Member output = malloc(sizeof(member));
-    if (output == NULL)
-        return NULL;
-    *output = (member) {id, 0, 0, 0, 0, false};
+void initMember(Member player, uint32_t id) {
+    *player = (member) {id, 0, 0, 0, 0, false, NULL, 0, 0, 0, true,
+                        0, 0, 0, false, false, NULL, 0, 0};
+}
+
+void clearMember(Member player) {
+    free(player->candidates);
+    free(player->watched);
+    player->candidates = NULL;
+    player->watched = NULL;
+}
+
+bool copyMember(Member copy, const member *player) {
+    *copy = *player;
+    copy->candidates = NULL;
+    copy->candidatesCapacity = player->candidatesSize;
+    copy->watched = NULL;
+    copy->watchedCapacity = player->watchedSize;
+
+    if (player->candidatesSize > 0) {
+        copy->candidates = malloc(player->candidatesSize * sizeof(cell_t));
+        if (copy->candidates == NULL)
+            return false;
+        memcpy(copy->candidates, player->candidates,
+               player->candidatesSize * sizeof(cell_t));
+    }
+
+    if (player->watchedSize > 0) {
+        copy->watched = malloc(player->watchedSize * sizeof(uint32_t));
+        if (copy->watched == NULL)
+            return false;
+        memcpy(copy->watched, player->watched,
+               player->watchedSize * sizeof(uint32_t));
+    }
+
+    return true;
+}
+
+void addCandidate(Member player, cell_t elem) {
+    if (!player->candidatesValid)
+        return;
+
+    // the same field is often added by consecutive moves
+    if (player->candidatesSize > 0 &&
+        player->candidates[player->candidatesSize - 1] == elem)
+        return;
 
-    return output;
+    if (player->candidatesSize == player->candidatesCapacity) {
+        uint64_t capacity = player->candidatesCapacity == 0 ?
+                            4 : 2 * player->candidatesCapacity;
+        cell_t *candidates = NULL;
+
+        if (capacity <= SIZE_MAX / sizeof(cell_t))
+            candidates = realloc(player->candidates,
+                                 capacity * sizeof(cell_t));
+
+        if (candidates == NULL) {
+            dropCandidates(player);
+            return;
+        }
+
+        player->candidates = candidates;
+        player->candidatesCapacity = capacity;
+    }
+
+    player->candidates[player->candidatesSize++] = elem;
+}
+
+void dropCandidates(Member player) {
+    // from now on golden moves are looked for on the whole board
+    free(player->candidates);
+    player->candidates = NULL;
+    player->candidatesSize = 0;
+    player->candidatesCapacity = 0;
+    player->candidatesCompacted = 0;
+    player->candidatesValid = false;
 }
 
-void removeMember(Member player) {
-    free(player);
+void addWatched(Member player, uint32_t id) {
+    if (player->watchedSize == player->watchedCapacity) {
+        uint64_t capacity = player->watchedCapacity == 0 ?
+                            4 : 2 * player->watchedCapacity;
+        uint32_t *watched = NULL;
+
+        if (capacity <= SIZE_MAX / sizeof(uint32_t))
+            watched = realloc(player->watched, capacity * sizeof(uint32_t));
+
+        if (watched == NULL) {
+            // result can't be trusted without all watched players
+            player->goldenKnown = false;
+            return;
+        }
+
+        player->watched = watched;
+        player->watchedCapacity = capacity;
+    }
+
+    player->watched[player->watchedSize++] = id;
 }
@@ -25,6 +25,28 @@ struct member {
 
     uint64_t surrounding;       /**< Number of empty fields surrounding */
     bool changedSurrounding;    /**< If surrounding fields were changed */
+
+    cell_t *candidates;         /**< Other players' fields that were next to
+                                     player's fields, may be outdated */
+    uint64_t candidatesSize;    /**< Number of candidates */
+    uint64_t candidatesCapacity;/**< Capacity of candidates */
+    uint64_t candidatesCompacted;/**< Number of candidates after the last
+                                     compaction */
+    bool candidatesValid;       /**< If candidates contain every field
+                                     of other player next to player's fields */
+
+    uint64_t changed;           /**< Last move that changed player's fields
+                                     or fields next to them */
+    uint64_t checked;           /**< Last move before golden move was looked
+                                     for */
+    uint64_t watchStamp;        /**< Last look up that watches player */
+    bool goldenKnown;           /**< If goldenPossible was found */
+    bool goldenPossible;        /**< If golden move could be done after
+                                     checked move */
+    uint32_t *watched;          /**< Players whose changes can make
+                                     goldenPossible outdated */
+    uint64_t watchedSize;       /**< Number of watched players */
+    uint64_t watchedCapacity;   /**< Capacity of watched */
 };
 
 /**
@@ -37,18 +59,50 @@ typedef struct member member;
  */
 typedef member * Member;
 
-/** @brief Creates new Member
- * Creates new member with id = @p id
+/** @brief Initializes Member
+ * Makes @p player a new member with id = @p id
+ * @param player - memory for Member
  * @param id - new member's id
- * @return pointer to new Member
  */
-Member newMember(uint32_t id);
+void initMember(Member player, uint32_t id);
+
+/** @brief Clears Member
+ * Frees memory owned by Member, but not Member itself
+ * @param player - Member to be cleared
+ */
+void clearMember(Member player);
+
+/** @brief Copies Member
+ * Makes @p copy an independent copy of @p player with its own candidates
+ * and watched players.
+ * @param copy - memory for copy
+ * @param player - copied Member
+ * @return false if there was not enough memory else true
+ */
+bool copyMember(Member copy, const member *player);
+
+/** @brief Remembers golden move candidate.
+ * Adds field @p elem to candidates of @p player. If there is not enough memory
+ * candidates are no longer valid.
+ * @param player - Member
+ * @param elem - index of field of other player next to @p player's field
+ */
+void addCandidate(Member player, cell_t elem);
+
+/** @brief Forgets golden move candidates.
+ * Frees candidates of @p player, who from now on has to look for golden
+ * move on the whole board.
+ * @param player - Member
+ */
+void dropCandidates(Member player);
 
-/** @brief Removes Member
- * Removes Member and clears memory
- * @param player - Member to be removed
+/** @brief Remembers player whose changes matter to golden move result.
+ * Adds @p id to watched players of @p player. If there is not enough memory
+ * remembered golden move result is forgotten.
+ * @param player - Member
+ * @param id - id of watched player
  */
-void removeMember(Member player);
+void addWatched(Member player, uint32_t id);
 
 
 #endif //GAMMA_PLAYER_H